@@ -2,6 +2,28 @@
 
 #include <raylib.h>
 
+namespace {
+struct SoundSpec {
+    const char* path;
+    int voices;
+    int priority;  // higher steals from lower once the voice cap is reached
+};
+
+// Indexed by SoundId.
+const SoundSpec kSounds[] = {
+    {"sounds/bounce.mp3", 6, 0},
+    {"sounds/gameover.mp3", 2, 1},
+};
+constexpr int kSoundCount = static_cast<int>(sizeof(kSounds) / sizeof(kSounds[0]));
+
+// Most voices sounding at once, across all sounds.
+constexpr int kMaxPlayingVoices = 6;
+
+int Priority(SoundId sound) {
+    return kSounds[static_cast<int>(sound)].priority;
+}
+}  // namespace
+
 AudioManager::AudioManager() = default;
 
 AudioManager::~AudioManager() {
@@ -15,8 +37,12 @@ void AudioManager::Init() {
         return;
     }
 
-    bounceSound_ = LoadSound("sounds/bounce.mp3");
-    gameOverSound_ = LoadSound("sounds/gameover.mp3");
+    for (int i = 0; i < kSoundCount; ++i) {
+        sounds_.push_back(LoadSound(kSounds[i].path));
+        for (int voice = 0; voice < kSounds[i].voices; ++voice) {
+            voices_.push_back(Voice{LoadSoundAlias(sounds_.back()), static_cast<SoundId>(i), 0});
+        }
+    }
 }
 
 void AudioManager::Shutdown() {
@@ -24,21 +50,73 @@ void AudioManager::Shutdown() {
         return;
     }
 
-    UnloadSound(bounceSound_);
-    UnloadSound(gameOverSound_);
+    for (const Voice& voice : voices_) {
+        UnloadSoundAlias(voice.alias);
+    }
+    for (const Sound& sound : sounds_) {
+        UnloadSound(sound);
+    }
+    voices_.clear();
+    sounds_.clear();
     CloseAudioDevice();
     ready_ = false;
 }
 
-void AudioManager::PlayBounce() {
+void AudioManager::Queue(SoundId sound) {
     if (ready_) {
-        PlaySound(bounceSound_);
+        commands_.Push(sound);
     }
 }
 
-void AudioManager::PlayGameOver() {
-    if (ready_) {
-        PlaySound(gameOverSound_);
+void AudioManager::Update() {
+    bool started[kSoundCount] = {};
+    SoundId sound{};
+    while (commands_.Pop(sound)) {
+        bool& once = started[static_cast<int>(sound)];
+        if (!once) {
+            once = true;
+            Start(sound);
+        }
     }
 }
 
+void AudioManager::Start(SoundId sound) {
+    Voice* freeVoice = nullptr;
+    Voice* oldestOwn = nullptr;
+    Voice* victim = nullptr;
+    int playing = 0;
+    for (Voice& voice : voices_) {
+        const bool busy = IsSoundPlaying(voice.alias);
+        if (voice.sound == sound) {
+            if (!busy && freeVoice == nullptr) {
+                freeVoice = &voice;
+            }
+            if (busy && (oldestOwn == nullptr || voice.started < oldestOwn->started)) {
+                oldestOwn = &voice;
+            }
+        }
+        if (busy) {
+            playing += 1;
+            if (victim == nullptr || Priority(voice.sound) < Priority(victim->sound) ||
+                (Priority(voice.sound) == Priority(victim->sound) && voice.started < victim->started)) {
+                victim = &voice;
+            }
+        }
+    }
+
+    Voice* voice = freeVoice;
+    if (voice == nullptr) {
+        // Restarting its own oldest voice keeps the number playing unchanged.
+        voice = oldestOwn;
+    } else if (playing >= kMaxPlayingVoices) {
+        if (Priority(victim->sound) > Priority(sound)) {
+            return;
+        }
+        StopSound(victim->alias);
+    }
+    if (voice == nullptr) {
+        return;
+    }
+    PlaySound(voice->alias);
+    voice->started = ++startCount_;
+}
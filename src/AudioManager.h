@@ -2,6 +2,19 @@
 
 #include <raylib.h>
 
+#include <cstdint>
+#include <vector>
+
+#include "SpscQueue.h"
+
+enum class SoundId : std::uint8_t {
+    Bounce,
+    GameOver,
+};
+
+// Sound effects played through a fixed pool of voices (aliases of the loaded sounds), so
+// overlapping triggers layer instead of restarting one another. The Play calls only queue
+// a command; Update, once per frame, starts the queued sounds.
 class AudioManager {
 public:
     AudioManager();
@@ -10,14 +23,32 @@ public:
     void Init();
     void Shutdown();
 
-    void PlayBounce();
-    void PlayGameOver();
+    // Never touch the device. After Init and before Shutdown, one thread may call these
+    // while another runs Update; only the command queue is shared between the threads.
+    void PlayBounce() { Queue(SoundId::Bounce); }
+    void PlayGameOver() { Queue(SoundId::GameOver); }
+    // Starts every sound queued since the last call, each at most once however often it
+    // was triggered.
+    void Update();
 
     bool IsReady() const { return ready_; }
 
 private:
+    struct Voice {
+        Sound alias{};
+        SoundId sound{SoundId::Bounce};
+        std::uint64_t started{0};  // start order, for stealing the oldest
+    };
+
+    void Queue(SoundId sound);
+    // Plays sound on a free voice of its own. With none free it takes over that sound's
+    // oldest voice; past the playing-voice cap it first stops the oldest voice of the
+    // lowest priority, and drops the trigger if every playing voice outranks it.
+    void Start(SoundId sound);
+
     bool ready_{false};
-    Sound bounceSound_{};
-    Sound gameOverSound_{};
+    std::vector<Sound> sounds_;  // by SoundId
+    std::vector<Voice> voices_;
+    std::uint64_t startCount_{0};
+    SpscQueue<SoundId, 64> commands_;
 };
-
@@ -0,0 +1,176 @@
+#include "BallSwarm.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ELEMENTAL_SWARM_SIMD 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ELEMENTAL_SWARM_SIMD 1
+#endif
+
+namespace {
+#if defined(__AVX__)
+// Eight lanes per iteration.
+struct Lanes {
+    using V = __m256;
+    static constexpr std::size_t kWidth = 8;
+    static V Load(const float* p) { return _mm256_loadu_ps(p); }
+    static void Store(float* p, V v) { _mm256_storeu_ps(p, v); }
+    static V Set(float value) { return _mm256_set1_ps(value); }
+    static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V Min(V a, V b) { return _mm256_min_ps(a, b); }
+    static V Max(V a, V b) { return _mm256_max_ps(a, b); }
+    static V And(V a, V b) { return _mm256_and_ps(a, b); }
+    static V Less(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static V LessEqual(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static V Abs(V v) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v); }
+    static V NegAbs(V v) { return _mm256_or_ps(_mm256_set1_ps(-0.0f), v); }
+    static V Select(V mask, V a, V b) { return _mm256_blendv_ps(b, a, mask); }
+};
+#elif defined(ELEMENTAL_SWARM_SIMD)
+// Four lanes per iteration; SSE2 has no blend, so selects are and/andnot/or.
+struct Lanes {
+    using V = __m128;
+    static constexpr std::size_t kWidth = 4;
+    static V Load(const float* p) { return _mm_loadu_ps(p); }
+    static void Store(float* p, V v) { _mm_storeu_ps(p, v); }
+    static V Set(float value) { return _mm_set1_ps(value); }
+    static V Add(V a, V b) { return _mm_add_ps(a, b); }
+    static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V Min(V a, V b) { return _mm_min_ps(a, b); }
+    static V Max(V a, V b) { return _mm_max_ps(a, b); }
+    static V And(V a, V b) { return _mm_and_ps(a, b); }
+    static V Less(V a, V b) { return _mm_cmplt_ps(a, b); }
+    static V LessEqual(V a, V b) { return _mm_cmple_ps(a, b); }
+    static V Abs(V v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+    static V NegAbs(V v) { return _mm_or_ps(_mm_set1_ps(-0.0f), v); }
+    static V Select(V mask, V a, V b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+};
+#endif
+}  // namespace
+
+void BallSwarm::Clear() {
+    x_.clear();
+    y_.clear();
+    vx_.clear();
+    vy_.clear();
+}
+
+void BallSwarm::Add(Vec2 position, Vec2 velocity) {
+    x_.push_back(position.x);
+    y_.push_back(position.y);
+    vx_.push_back(velocity.x);
+    vy_.push_back(velocity.y);
+}
+
+void BallSwarm::Integrate(float dt, float worldWidth, float floorY) {
+    const float left = radius_;
+    const float right = worldWidth - radius_;
+    const float top = radius_;
+    const float bottom = floorY - radius_;
+    const std::size_t count = x_.size();
+    std::size_t i = 0;
+
+#if defined(ELEMENTAL_SWARM_SIMD)
+    const Lanes::V vDt = Lanes::Set(dt);
+    const Lanes::V vLeft = Lanes::Set(left);
+    const Lanes::V vRight = Lanes::Set(right);
+    const Lanes::V vTop = Lanes::Set(top);
+    const Lanes::V vBottom = Lanes::Set(bottom);
+    for (; i + Lanes::kWidth <= count; i += Lanes::kWidth) {
+        Lanes::V vx = Lanes::Load(&vx_[i]);
+        Lanes::V vy = Lanes::Load(&vy_[i]);
+        Lanes::V x = Lanes::Add(Lanes::Load(&x_[i]), Lanes::Mul(vx, vDt));
+        Lanes::V y = Lanes::Add(Lanes::Load(&y_[i]), Lanes::Mul(vy, vDt));
+
+        vx = Lanes::Select(Lanes::Less(x, vLeft), Lanes::Abs(vx), vx);
+        vx = Lanes::Select(Lanes::Less(vRight, x), Lanes::NegAbs(vx), vx);
+        vy = Lanes::Select(Lanes::Less(y, vTop), Lanes::Abs(vy), vy);
+        vy = Lanes::Select(Lanes::Less(vBottom, y), Lanes::NegAbs(vy), vy);
+        x = Lanes::Min(Lanes::Max(x, vLeft), vRight);
+        y = Lanes::Min(Lanes::Max(y, vTop), vBottom);
+
+        Lanes::Store(&x_[i], x);
+        Lanes::Store(&y_[i], y);
+        Lanes::Store(&vx_[i], vx);
+        Lanes::Store(&vy_[i], vy);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        float x = x_[i] + vx_[i] * dt;
+        float y = y_[i] + vy_[i] * dt;
+        if (x < left) {
+            vx_[i] = std::fabs(vx_[i]);
+        }
+        if (right < x) {
+            vx_[i] = -std::fabs(vx_[i]);
+        }
+        if (y < top) {
+            vy_[i] = std::fabs(vy_[i]);
+        }
+        if (bottom < y) {
+            vy_[i] = -std::fabs(vy_[i]);
+        }
+        x_[i] = std::min(std::max(x, left), right);
+        y_[i] = std::min(std::max(y, top), bottom);
+    }
+}
+
+void BallSwarm::BounceOffPaddle(const Rect& paddle) {
+    const float minX = paddle.x - radius_;
+    const float maxX = paddle.x + paddle.width + radius_;
+    const float minY = paddle.y - radius_;
+    const float maxY = paddle.y + paddle.height;
+    const std::size_t count = x_.size();
+    std::size_t i = 0;
+
+#if defined(ELEMENTAL_SWARM_SIMD)
+    const Lanes::V vMinX = Lanes::Set(minX);
+    const Lanes::V vMaxX = Lanes::Set(maxX);
+    const Lanes::V vMinY = Lanes::Set(minY);
+    const Lanes::V vMaxY = Lanes::Set(maxY);
+    const Lanes::V vZero = Lanes::Set(0.0f);
+    for (; i + Lanes::kWidth <= count; i += Lanes::kWidth) {
+        Lanes::V x = Lanes::Load(&x_[i]);
+        Lanes::V y = Lanes::Load(&y_[i]);
+        Lanes::V vy = Lanes::Load(&vy_[i]);
+        Lanes::V hit = Lanes::And(Lanes::And(Lanes::Less(vZero, vy), Lanes::LessEqual(vMinY, y)),
+                                  Lanes::And(Lanes::LessEqual(y, vMaxY),
+                                             Lanes::And(Lanes::LessEqual(vMinX, x), Lanes::LessEqual(x, vMaxX))));
+        Lanes::Store(&vy_[i], Lanes::Select(hit, Lanes::NegAbs(vy), vy));
+        Lanes::Store(&y_[i], Lanes::Select(hit, vMinY, y));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        if (vy_[i] > 0.0f && y_[i] >= minY && y_[i] <= maxY && x_[i] >= minX && x_[i] <= maxX) {
+            vy_[i] = -std::fabs(vy_[i]);
+            y_[i] = minY;
+        }
+    }
+}
+
+int BallSwarm::RemoveBelow(float y) {
+    const std::size_t count = x_.size();
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (y_[i] > y) {
+            continue;
+        }
+        x_[kept] = x_[i];
+        y_[kept] = y_[i];
+        vx_[kept] = vx_[i];
+        vy_[kept] = vy_[i];
+        kept += 1;
+    }
+    x_.resize(kept);
+    y_.resize(kept);
+    vx_.resize(kept);
+    vy_.resize(kept);
+    return static_cast<int>(count - kept);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "SimTypes.h"
+
+// Extra balls (split power-up, stress runs) in structure-of-arrays form.
+//
+// They carry no element or status effects: they bounce off the walls, the paddle and
+// bricks and chip bricks like a neutral ball. Movement and the wall and paddle tests
+// run as vector loops over the coordinate arrays (AVX or SSE2 when the compiler
+// targets them, scalar otherwise); brick contacts are resolved per ball by the
+// simulation, which reads and writes the arrays directly.
+class BallSwarm {
+public:
+    void Clear();
+    void Add(Vec2 position, Vec2 velocity);
+
+    std::size_t Size() const { return x_.size(); }
+    bool Empty() const { return x_.empty(); }
+    float Radius() const { return radius_; }
+    void SetRadius(float radius) { radius_ = radius; }
+
+    float* X() { return x_.data(); }
+    float* Y() { return y_.data(); }
+    float* VelocityX() { return vx_.data(); }
+    float* VelocityY() { return vy_.data(); }
+    const float* X() const { return x_.data(); }
+    const float* Y() const { return y_.data(); }
+
+    // Moves every ball by dt and reflects it off the side walls at 0 and worldWidth,
+    // the ceiling, and the floor at floorY (pass infinity for an open floor).
+    void Integrate(float dt, float worldWidth, float floorY);
+    // Sends every descending ball that reaches the paddle back up.
+    void BounceOffPaddle(const Rect& paddle);
+    // Drops balls whose centre is below y, keeping the rest in order; returns how many.
+    int RemoveBelow(float y);
+
+private:
+    std::vector<float> x_;
+    std::vector<float> y_;
+    std::vector<float> vx_;
+    std::vector<float> vy_;
+    float radius_{9.0f};
+};
@@ -0,0 +1,225 @@
+// Headless balance runner: plays many independent games across all cores with a bot
+// driving each one and reports aggregate outcomes and throughput.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BotPolicy.h"
+#include "GameConstants.h"
+#include "ReactionRules.h"
+#include "Rng.h"
+#include "Simulation.h"
+#include "WorkStealingPool.h"
+
+namespace {
+struct BatchOptions {
+    std::uint64_t games{1000};
+    int threads{0};
+    std::uint64_t baseSeed{1};
+    BotKind bot{BotKind::Tracker};
+    float maxSeconds{600.0f};
+    int hz{DefaultSimulationHz};
+    bool json{false};
+    SimulationConfig config{};
+    ReactionRules rules{ReactionRules::Defaults()};
+};
+
+struct GameResult {
+    int score{0};
+    int wavesCleared{0};
+    int reactionsTriggered{0};
+    float runTime{0.0f};
+    std::uint64_t steps{0};
+    bool timedOut{false};
+};
+
+struct Totals {
+    std::uint64_t games{0};
+    std::uint64_t steps{0};
+    std::uint64_t timedOut{0};
+    double score{0.0};
+    double scoreSquared{0.0};
+    int minScore{std::numeric_limits<int>::max()};
+    int maxScore{0};
+    double waves{0.0};
+    double reactions{0.0};
+    double runTime{0.0};
+
+    void Add(const GameResult& result) {
+        games += 1;
+        steps += result.steps;
+        timedOut += result.timedOut ? 1 : 0;
+        score += result.score;
+        scoreSquared += static_cast<double>(result.score) * result.score;
+        minScore = std::min(minScore, result.score);
+        maxScore = std::max(maxScore, result.score);
+        waves += result.wavesCleared;
+        reactions += result.reactionsTriggered;
+        runTime += result.runTime;
+    }
+
+    void Merge(const Totals& other) {
+        games += other.games;
+        steps += other.steps;
+        timedOut += other.timedOut;
+        score += other.score;
+        scoreSquared += other.scoreSquared;
+        minScore = std::min(minScore, other.minScore);
+        maxScore = std::max(maxScore, other.maxScore);
+        waves += other.waves;
+        reactions += other.reactions;
+        runTime += other.runTime;
+    }
+};
+
+// Pads each worker's totals onto its own cache line so the workers never share one.
+struct alignas(64) WorkerTotals {
+    Totals totals;
+};
+
+GameResult RunGame(const BatchOptions& options, std::uint64_t seed) {
+    Simulation simulation(options.config);
+    simulation.Seed(seed);
+    simulation.ResetRun();
+    BotPolicy policy(options.bot, seed ^ 0xB07B07B07B07B07Bull);
+
+    const float stepDt = 1.0f / static_cast<float>(options.hz);
+    const auto maxSteps = static_cast<std::uint64_t>(options.maxSeconds * static_cast<float>(options.hz));
+
+    GameResult result{};
+    while (!simulation.IsGameOver() && result.steps < maxSteps) {
+        InputFrame input = policy.Decide(simulation, stepDt);
+        input.restart = false;  // one run per game
+        simulation.Step(input, stepDt);
+        result.steps += 1;
+    }
+
+    result.score = simulation.Score();
+    result.wavesCleared = simulation.Stats().wavesCleared;
+    result.reactionsTriggered = simulation.Stats().reactionsTriggered;
+    result.runTime = simulation.Stats().runTime;
+    result.timedOut = !simulation.IsGameOver();
+    return result;
+}
+
+bool ParseArgs(int argc, char** argv, BatchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--games") == 0 && hasValue) {
+            options.games = std::strtoull(argv[++i], nullptr, 0);
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            options.baseSeed = std::strtoull(argv[++i], nullptr, 0);
+        } else if (std::strcmp(arg, "--bot") == 0 && hasValue) {
+            const char* bot = argv[++i];
+            if (std::strcmp(bot, "tracker") == 0) {
+                options.bot = BotKind::Tracker;
+            } else if (std::strcmp(bot, "random") == 0) {
+                options.bot = BotKind::Random;
+            } else {
+                std::fprintf(stderr, "Unknown bot '%s' (expected tracker or random)\n", bot);
+                return false;
+            }
+        } else if (std::strcmp(arg, "--max-seconds") == 0 && hasValue) {
+            options.maxSeconds = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(arg, "--hz") == 0 && hasValue) {
+            options.hz = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--neutral") == 0 && hasValue) {
+            options.config.spawn.neutralPercent = std::clamp(std::atoi(argv[++i]), 0, 100);
+        } else if (std::strcmp(arg, "--green") == 0 && hasValue) {
+            options.config.spawn.greenPercent = std::clamp(std::atoi(argv[++i]), 0, 100);
+        } else if (std::strcmp(arg, "--gap") == 0 && hasValue) {
+            options.config.spawn.gapPercent = std::clamp(std::atoi(argv[++i]), 0, 100);
+        } else if (std::strcmp(arg, "--split-chance") == 0 && hasValue) {
+            options.config.splitChancePercent = std::clamp(std::atoi(argv[++i]), 0, 100);
+        } else if (std::strcmp(arg, "--rules") == 0 && hasValue) {
+            const char* path = argv[++i];
+            std::string error;
+            if (!LoadReactionRules(path, options.rules, error)) {
+                std::fprintf(stderr, "Could not load rules '%s': %s\n", path, error.c_str());
+                return false;
+            }
+        } else if (std::strcmp(arg, "--json") == 0) {
+            options.json = true;
+        } else {
+            std::fprintf(stderr,
+                         "usage: elemental_batch [--games N] [--threads N] [--seed N] [--bot tracker|random]\n"
+                         "                       [--max-seconds S] [--hz N] [--neutral P] [--green P] [--gap P]\n"
+                         "                       [--split-chance P] [--rules FILE] [--json]\n");
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    BatchOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        return 1;
+    }
+    options.config.rules = &options.rules;
+    if (options.threads <= 0) {
+        options.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    WorkStealingPool pool(options.threads);
+    std::vector<WorkerTotals> workerTotals(pool.WorkerCount());
+
+    auto start = std::chrono::steady_clock::now();
+    pool.ParallelFor(static_cast<std::size_t>(options.games), 16, [&](std::size_t index, int worker) {
+        std::uint64_t seed = Rng(options.baseSeed + index).Next();
+        workerTotals[worker].totals.Add(RunGame(options, seed));
+    });
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Totals totals{};
+    for (const WorkerTotals& worker : workerTotals) {
+        totals.Merge(worker.totals);
+    }
+
+    const double games = std::max<double>(1.0, static_cast<double>(totals.games));
+    const double meanScore = totals.score / games;
+    const double scoreStdDev = std::sqrt(std::max(0.0, totals.scoreSquared / games - meanScore * meanScore));
+    const double gamesPerSecond = static_cast<double>(totals.games) / std::max(elapsed, 1e-9);
+    const double gamesPerSecondPerCore = gamesPerSecond / pool.WorkerCount();
+    const double stepsPerSecond = static_cast<double>(totals.steps) / std::max(elapsed, 1e-9);
+    if (totals.games == 0) {
+        totals.minScore = 0;
+    }
+
+    if (options.json) {
+        std::printf("{\"games\": %llu, \"threads\": %d, \"seed\": %llu, \"score_mean\": %.3f, \"score_stddev\": %.3f, "
+                    "\"score_min\": %d, \"score_max\": %d, \"waves_mean\": %.3f, \"reactions_mean\": %.3f, "
+                    "\"run_seconds_mean\": %.3f, \"timed_out\": %llu, \"wall_seconds\": %.3f, \"games_per_sec\": %.1f, "
+                    "\"games_per_sec_per_core\": %.1f, \"steps_per_sec\": %.0f}\n",
+                    static_cast<unsigned long long>(totals.games), pool.WorkerCount(),
+                    static_cast<unsigned long long>(options.baseSeed), meanScore, scoreStdDev, totals.minScore,
+                    totals.maxScore, totals.waves / games, totals.reactions / games, totals.runTime / games,
+                    static_cast<unsigned long long>(totals.timedOut), elapsed, gamesPerSecond, gamesPerSecondPerCore,
+                    stepsPerSecond);
+        return 0;
+    }
+
+    std::printf("games            %llu on %d threads (base seed %llu)\n", static_cast<unsigned long long>(totals.games),
+                pool.WorkerCount(), static_cast<unsigned long long>(options.baseSeed));
+    std::printf("score            mean %.2f  stddev %.2f  min %d  max %d\n", meanScore, scoreStdDev, totals.minScore,
+                totals.maxScore);
+    std::printf("waves cleared    mean %.3f\n", totals.waves / games);
+    std::printf("reactions        mean %.2f\n", totals.reactions / games);
+    std::printf("run length       mean %.1f s  (%llu hit the %.0f s cap)\n", totals.runTime / games,
+                static_cast<unsigned long long>(totals.timedOut), options.maxSeconds);
+    std::printf("throughput       %.1f games/s  %.1f games/s/core  %.0f steps/s  (%.2f s wall)\n", gamesPerSecond,
+                gamesPerSecondPerCore, stepsPerSecond, elapsed);
+    return 0;
+}
@@ -0,0 +1,362 @@
+// Microbenchmarks for the simulation hot paths across grid sizes. Every case times a
+// single call against a freshly prepared state and reports robust statistics.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "BrickReactions.h"
+#include "GameConstants.h"
+#include "Rng.h"
+#include "Simulation.h"
+
+class SimulationProbe {
+public:
+    static BrickField& Bricks(Simulation& simulation) { return simulation.bricks_; }
+    static Ball& GetBall(Simulation& simulation) { return simulation.ball_; }
+    static ReactionQueue& Events(Simulation& simulation) { return simulation.reactionEvents_; }
+    static ReactionCascade& Cascade(Simulation& simulation) { return simulation.cascade_; }
+    static int AdvanceBall(Simulation& simulation, float dt) { return simulation.AdvanceBall(dt); }
+    static int HandleBallBrickCollision(Simulation& simulation, int cell, Vec2 normal) {
+        return simulation.HandleBallBrickCollision(cell, normal);
+    }
+    static int ResolveReactionEvents(Simulation& simulation, float dt) { return simulation.ResolveReactionEvents(dt); }
+    static int UpdateExtraBalls(Simulation& simulation, float dt) { return simulation.UpdateExtraBalls(dt); }
+};
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+volatile std::int64_t gSink = 0;
+
+struct GridSize {
+    int rows;
+    int cols;
+};
+
+struct BenchOptions {
+    std::vector<GridSize> sizes{{7, 12}, {64, 64}, {128, 128}, {256, 256}, {512, 512}};
+    std::string filter;
+    double minSeconds{0.25};
+    bool json{false};
+};
+
+struct BenchResult {
+    std::string name;
+    GridSize size;
+    std::size_t iterations;
+    double medianNs;
+    double p99Ns;
+    double meanNs;
+    double minNs;
+};
+
+// Runs setup (untimed) then op (timed) until minSeconds of op time and at least a few
+// iterations have accumulated. Setup-heavy cases are also bounded by wall time.
+template <typename Setup, typename Op>
+BenchResult Measure(const std::string& name, GridSize size, double minSeconds, Setup&& setup, Op&& op) {
+    constexpr std::size_t kMinIterations = 3;
+    constexpr std::size_t kMaxIterations = 1000000;
+
+    setup();
+    gSink = gSink + op();  // warm caches and first-touch allocations
+
+    std::vector<double> samples;
+    samples.reserve(1024);
+    double timed = 0.0;
+    const auto wallStart = Clock::now();
+    while (samples.size() < kMaxIterations) {
+        if (samples.size() >= kMinIterations &&
+            (timed >= minSeconds || std::chrono::duration<double>(Clock::now() - wallStart).count() >= minSeconds * 20.0)) {
+            break;
+        }
+        setup();
+        const auto start = Clock::now();
+        gSink = gSink + op();
+        const auto end = Clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        samples.push_back(ns);
+        timed += ns * 1e-9;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    const std::size_t count = samples.size();
+    return BenchResult{
+        name,
+        size,
+        count,
+        samples[count / 2],
+        samples[std::min(count - 1, (count * 99) / 100)],
+        sum / static_cast<double>(count),
+        samples.front(),
+    };
+}
+
+// Keeps the default brick size and grows the world to fit the grid.
+SimulationConfig ConfigForGrid(GridSize size) {
+    SimulationConfig config{};
+    config.brickRows = size.rows;
+    config.brickCols = size.cols;
+    config.brickWidth = BrickWidth;
+    FitWorldToGrid(config);
+    return config;
+}
+
+// First active cell at or after the middle of the grid (the grid is never empty here).
+int CenterCell(const BrickField& bricks) {
+    int cell = bricks.NextActive(bricks.CellIndex(bricks.Rows() / 2, bricks.Cols() / 2));
+    return cell != -1 ? cell : bricks.NextActive(0);
+}
+
+void RunGrid(GridSize size, const BenchOptions& options, std::vector<BenchResult>& results) {
+    const SimulationConfig config = ConfigForGrid(size);
+    SimulationConfig solidConfig = config;
+    solidConfig.spawn.neutralPercent = 100;
+    solidConfig.spawn.gapPercent = 0;
+
+    Rng rng(1234);
+    BrickField wave;
+    CreateBricks(wave, rng, config);
+    BrickField solid;
+    CreateBricks(solid, rng, solidConfig);
+    BrickField frozen = solid;
+    FreezeConnectedBricks(frozen, 0, 0, kColorIndexNone);
+
+    const int waveCenter = CenterCell(wave);
+    const int centerRow = wave.RowOf(waveCenter);
+    const int centerCol = wave.ColOf(waveCenter);
+
+    // Empty but for one brick at the far end of each diagonal from the centre.
+    BrickField sparse;
+    sparse.Reset(size.rows, size.cols);
+    const int reach = std::min({centerRow, centerCol, size.rows - 1 - centerRow, size.cols - 1 - centerCol});
+    for (int rowStep : {-1, 1}) {
+        for (int colStep : {-1, 1}) {
+            const int row = centerRow + rowStep * reach;
+            const int col = centerCol + colStep * reach;
+            sparse.Place(row, col, wave.BrickRect(waveCenter), kColorIndexBlue, 2);
+        }
+    }
+
+    auto wants = [&](const char* name) {
+        return options.filter.empty() || std::string(name).find(options.filter) != std::string::npos;
+    };
+    auto run = [&](const char* name, auto&& setup, auto&& op) {
+        if (wants(name)) {
+            results.push_back(Measure(name, size, options.minSeconds, setup, op));
+        }
+    };
+
+    BrickField scratch;
+    ReactionQueue events;
+
+    run("CreateBricks", [] {}, [&] {
+        CreateBricks(scratch, rng, config);
+        return scratch.CountActive();
+    });
+
+    run("FreezeConnectedBricks", [&] { scratch = solid; }, [&] {
+        return FreezeConnectedBricks(scratch, size.rows / 2, size.cols / 2, kColorIndexNone);
+    });
+
+    run("ThawFrozenCluster", [&] { scratch = frozen; }, [&] {
+        ThawFrozenCluster(scratch, size.rows / 2, size.cols / 2);
+        return 0;
+    });
+
+    ReactionCascade breaks;
+    run("OverloadedAoE", [&] {
+        scratch = wave;
+        breaks.Reset(scratch.CellCount());
+    }, [&] {
+        QueueOverloadedAoE(breaks, scratch, centerRow, centerCol, 1, AoEShape::Square, kColorIndexPurple);
+        return breaks.Run(scratch, std::numeric_limits<int>::max());
+    });
+
+    // A power-up sized blast; costs the same on any board it fits in.
+    run("OverloadedAoECircle16", [&] {
+        scratch = wave;
+        breaks.Reset(scratch.CellCount());
+    }, [&] {
+        QueueOverloadedAoE(breaks, scratch, centerRow, centerCol, 16, AoEShape::Circle, kColorIndexPurple);
+        return breaks.Run(scratch, std::numeric_limits<int>::max());
+    });
+
+    run("ScheduleSurgeChain", [&] { events.Clear(); }, [&] {
+        ScheduleSurgeChain(events, wave, centerRow, centerCol, 4, SurgeChainStepDelay, kColorIndexPurple);
+        return static_cast<int>(events.Size());
+    });
+
+    run("ScheduleSurgeChainSparse", [&] { events.Clear(); }, [&] {
+        ScheduleSurgeChain(events, sparse, centerRow, centerCol, 4, SurgeChainStepDelay, kColorIndexPurple);
+        return static_cast<int>(events.Size());
+    });
+
+    // One break in the middle of a fully frozen board shatters all of it.
+    run("ShatterFrozenBoard", [&] {
+        scratch = frozen;
+        breaks.Reset(scratch.CellCount());
+    }, [&] {
+        breaks.Push(scratch.CellIndex(size.rows / 2, size.cols / 2), CascadeAction::Break, kColorIndexBlue);
+        return breaks.Run(scratch, std::numeric_limits<int>::max());
+    });
+
+    Simulation simulation(config);
+    simulation.Seed(1);
+    simulation.ResetRun();
+    BrickField& bricks = SimulationProbe::Bricks(simulation);
+    Ball& ball = SimulationProbe::GetBall(simulation);
+    bricks = wave;
+
+    // A plain hit: neutral ball on a yellow or coloured brick, restored after every call.
+    const Rect hitRect = wave.BrickRect(waveCenter);
+    run("HandleBallBrickCollision", [&] {
+        bricks.Place(centerRow, centerCol, hitRect, wave.Element(waveCenter), 2);
+        ball.inPlay = true;
+        ball.colorIndex = kColorIndexNone;
+        ball.position = {hitRect.x + hitRect.width * 0.5f, hitRect.y + hitRect.height + ball.radius};
+        ball.velocity = {0.0f, -ball.speed};
+    }, [&] {
+        return SimulationProbe::HandleBallBrickCollision(simulation, waveCenter, Vec2{0.0f, 1.0f});
+    });
+
+    // One step of the collision sweep with the ball in open space below the bricks.
+    const float openY = wave.LayoutBottom() + 200.0f;
+    run("AdvanceBall", [&] {
+        ball.inPlay = true;
+        ball.frozen = false;
+        ball.superconduct = false;
+        ball.position = {config.worldWidth * 0.5f, openY};
+        ball.velocity = {ball.speed * 0.6f, -ball.speed * 0.8f};
+    }, [&] {
+        return SimulationProbe::AdvanceBall(simulation, 1.0f / DefaultSimulationHz);
+    });
+
+    // A big cascade: one queued event per fourth live brick, half of them due now.
+    ReactionQueue cascade;
+    int index = 0;
+    for (int cell = wave.NextActive(0); cell != -1; cell = wave.NextActive(cell + 1), ++index) {
+        if (index % 4 != 0) {
+            continue;
+        }
+        bool due = (index / 4) % 2 == 0;
+        ReactionKind kind = (index / 8) % 2 == 0 ? ReactionKind::SurgeChain : ReactionKind::OverloadAoE;
+        cascade.Schedule(ReactionEvent{wave.RowOf(cell), wave.ColOf(cell), kind, 1, AoEShape::Square, kColorIndexPurple},
+                         due ? 0.0f : 1.0f);
+    }
+    ReactionQueue& queued = SimulationProbe::Events(simulation);
+    run("ResolveReactionEvents", [&] {
+        bricks = wave;
+        queued = cascade;
+        SimulationProbe::Cascade(simulation).Reset(bricks.CellCount());
+    }, [&] {
+        return SimulationProbe::ResolveReactionEvents(simulation, 1.0f / DefaultSimulationHz);
+    });
+}
+
+// The multi-ball stress scenario: one step of 10k extra balls over the grid.
+void RunSwarm(GridSize size, const BenchOptions& options, std::vector<BenchResult>& results) {
+    const char* name = "UpdateExtraBalls";
+    if (!options.filter.empty() && std::string(name).find(options.filter) == std::string::npos) {
+        return;
+    }
+    SimulationConfig config = ConfigForGrid(size);
+    config.stressBalls = 10000;
+    Simulation simulation(config);
+    simulation.Seed(1);
+    simulation.ResetRun();
+    results.push_back(Measure(name, size, options.minSeconds, [] {}, [&] {
+        return SimulationProbe::UpdateExtraBalls(simulation, 1.0f / DefaultSimulationHz);
+    }));
+}
+
+bool ParseSizes(const char* text, std::vector<GridSize>& sizes) {
+    sizes.clear();
+    const char* cursor = text;
+    while (*cursor != '\0') {
+        char* end = nullptr;
+        long rows = std::strtol(cursor, &end, 10);
+        if (end == cursor || *end != 'x') {
+            return false;
+        }
+        cursor = end + 1;
+        long cols = std::strtol(cursor, &end, 10);
+        if (end == cursor || rows <= 0 || cols <= 0) {
+            return false;
+        }
+        sizes.push_back({static_cast<int>(rows), static_cast<int>(cols)});
+        cursor = end;
+        if (*cursor == ',') {
+            ++cursor;
+        }
+    }
+    return !sizes.empty();
+}
+
+bool ParseArgs(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--sizes") == 0 && hasValue) {
+            if (!ParseSizes(argv[++i], options.sizes)) {
+                std::fprintf(stderr, "--sizes expects ROWSxCOLS[,ROWSxCOLS...]\n");
+                return false;
+            }
+        } else if (std::strcmp(arg, "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(arg, "--min-time") == 0 && hasValue) {
+            options.minSeconds = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--json") == 0) {
+            options.json = true;
+        } else {
+            std::fprintf(stderr, "usage: elemental_bench [--sizes 7x12,512x512] [--filter NAME] [--min-time S] [--json]\n");
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        return 1;
+    }
+
+    std::vector<BenchResult> results;
+    for (const GridSize& size : options.sizes) {
+        RunGrid(size, options, results);
+        RunSwarm(size, options, results);
+    }
+
+    if (options.json) {
+        std::printf("[\n");
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const BenchResult& r = results[i];
+            std::printf("  {\"name\": \"%s\", \"rows\": %d, \"cols\": %d, \"iterations\": %zu, \"median_ns\": %.1f, "
+                        "\"p99_ns\": %.1f, \"mean_ns\": %.1f, \"min_ns\": %.1f}%s\n",
+                        r.name.c_str(), r.size.rows, r.size.cols, r.iterations, r.medianNs, r.p99Ns, r.meanNs, r.minNs,
+                        i + 1 < results.size() ? "," : "");
+        }
+        std::printf("]\n");
+        return 0;
+    }
+
+    std::printf("%-26s %10s %10s %14s %14s %14s\n", "benchmark", "grid", "iters", "median", "p99", "mean");
+    for (const BenchResult& r : results) {
+        char grid[32];
+        std::snprintf(grid, sizeof(grid), "%dx%d", r.size.rows, r.size.cols);
+        std::printf("%-26s %10s %10zu %11.0f ns %11.0f ns %11.0f ns\n", r.name.c_str(), grid, r.iterations, r.medianNs,
+                    r.p99Ns, r.meanNs);
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include "BotPolicy.h"
+
+#include "Elements.h"
+#include "Simulation.h"
+
+BotPolicy::BotPolicy(BotKind kind, std::uint64_t seed) : kind_(kind), rng_(seed) {}
+
+InputFrame BotPolicy::Decide(const Simulation& simulation, float dt) {
+    if (kind_ == BotKind::Random) {
+        return DecideRandom();
+    }
+    return DecideTracker(simulation, dt);
+}
+
+InputFrame BotPolicy::DecideTracker(const Simulation& simulation, float dt) {
+    const Ball& ball = simulation.GetBall();
+    const Paddle& paddle = simulation.GetPaddle();
+
+    InputFrame input{};
+    input.restart = simulation.IsGameOver();
+    input.launch = !ball.inPlay;
+
+    // Re-pick where on the paddle to catch the ball a few times a second; the spread is
+    // what makes the bot miss once the ball gets fast.
+    retargetTimer_ -= dt;
+    if (retargetTimer_ <= 0.0f) {
+        retargetTimer_ = 0.25f;
+        aimOffset_ = static_cast<float>(rng_.Range(-100, 100)) * 0.01f * paddle.rect.width * 0.6f;
+    }
+
+    float paddleCenter = paddle.rect.x + paddle.rect.width * 0.5f;
+    float target = ball.position.x + aimOffset_;
+    const float deadZone = 6.0f;
+    input.moveLeft = target < paddleCenter - deadZone;
+    input.moveRight = target > paddleCenter + deadZone;
+
+    swapTimer_ -= dt;
+    if (swapTimer_ <= 0.0f) {
+        swapTimer_ = static_cast<float>(rng_.Range(20, 60)) * 0.1f;
+        input.elementSwap = rng_.Range(0, kElementCount - 1);
+    }
+    return input;
+}
+
+InputFrame BotPolicy::DecideRandom() {
+    InputFrame input{};
+    int move = rng_.Range(0, 2);
+    input.moveLeft = move == 1;
+    input.moveRight = move == 2;
+    input.launch = rng_.Range(0, 99) < 5;
+    input.restart = true;
+    if (rng_.Range(0, 999) < 2) {
+        input.elementSwap = rng_.Range(0, kElementCount - 1);
+    }
+    return input;
+}
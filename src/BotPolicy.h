@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+#include "InputFrame.h"
+#include "Rng.h"
+
+class Simulation;
+
+enum class BotKind {
+    Tracker,  // follows the ball with some lag and aim noise, swaps elements now and then
+    Random,   // mashes keys; a floor for balance comparisons
+};
+
+// Scripted player for headless runs. Deterministic for a given seed, so a batch run
+// with the same base seed reproduces exactly.
+class BotPolicy {
+public:
+    BotPolicy(BotKind kind, std::uint64_t seed);
+
+    InputFrame Decide(const Simulation& simulation, float dt);
+
+private:
+    InputFrame DecideTracker(const Simulation& simulation, float dt);
+    InputFrame DecideRandom();
+
+    BotKind kind_;
+    Rng rng_;
+    float aimOffset_{0.0f};
+    float retargetTimer_{0.0f};
+    float swapTimer_{0.0f};
+};
@@ -0,0 +1,377 @@
+#include "BrickField.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+namespace {
+// Grows `seeds` along runs of set bits in `propagate`, toward higher bits then lower
+// bits, doubling the reach each step (Kogge-Stone occluded fill).
+std::uint64_t FillWordUp(std::uint64_t seeds, std::uint64_t propagate) {
+    seeds |= propagate & (seeds << 1);
+    propagate &= propagate << 1;
+    seeds |= propagate & (seeds << 2);
+    propagate &= propagate << 2;
+    seeds |= propagate & (seeds << 4);
+    propagate &= propagate << 4;
+    seeds |= propagate & (seeds << 8);
+    propagate &= propagate << 8;
+    seeds |= propagate & (seeds << 16);
+    propagate &= propagate << 16;
+    seeds |= propagate & (seeds << 32);
+    return seeds;
+}
+
+std::uint64_t FillWordDown(std::uint64_t seeds, std::uint64_t propagate) {
+    seeds |= propagate & (seeds >> 1);
+    propagate &= propagate >> 1;
+    seeds |= propagate & (seeds >> 2);
+    propagate &= propagate >> 2;
+    seeds |= propagate & (seeds >> 4);
+    propagate &= propagate >> 4;
+    seeds |= propagate & (seeds >> 8);
+    propagate &= propagate >> 8;
+    seeds |= propagate & (seeds >> 16);
+    propagate &= propagate >> 16;
+    seeds |= propagate & (seeds >> 32);
+    return seeds;
+}
+
+// Expands the seeded bits of one row across every horizontal run of candidates they
+// touch, carrying between words.
+void FillRow(std::uint64_t* row, const std::uint64_t* seeds, const std::uint64_t* candidates, int words) {
+    std::uint64_t carry = 0;
+    for (int w = 0; w < words; ++w) {
+        std::uint64_t filled = FillWordUp((seeds[w] | carry) & candidates[w], candidates[w]);
+        carry = filled >> 63;
+        row[w] = filled;
+    }
+    carry = 0;
+    for (int w = words - 1; w >= 0; --w) {
+        std::uint64_t filled = FillWordDown(row[w] | ((carry << 63) & candidates[w]), candidates[w]);
+        carry = filled & 1u;
+        row[w] = filled;
+    }
+}
+}  // namespace
+
+void BrickField::Reset(int rows, int cols) {
+    rows_ = rows;
+    cols_ = cols;
+    stride_ = ((cols + 63) / 64) * 64;
+    layoutOrigin_ = {};
+    layoutPitch_ = {};
+
+    const int cellCount = CellCount();
+    const std::size_t wordCount = static_cast<std::size_t>(cellCount / 64);
+    activeMask_.assign(wordCount, 0);
+    rects_.assign(cellCount, Rect{});
+    elements_.assign(cellCount, -1);
+    hitPoints_.assign(cellCount, 0);
+    elementMasks_.assign(wordCount * (kElementCount + 1), 0);
+    frozenMask_.assign(wordCount, 0);
+    diagonalWords_ = (rows + 63) / 64;
+    diagonals_.assign(static_cast<std::size_t>(2 * (rows + cols - 1)) * diagonalWords_, 0);
+    cluster_.assign(wordCount, 0);
+    clusterSeeds_.assign(static_cast<std::size_t>(stride_ / 64), 0);
+    clusterRowBegin_ = 0;
+    clusterRowEnd_ = 0;
+    activeCount_ = 0;
+    std::fill(std::begin(elementCounts_), std::end(elementCounts_), 0);
+    flags_.assign(cellCount, 0);
+    originalElements_.assign(cellCount, -1);
+    dirtyMask_.assign(wordCount, 0);
+    allDirty_ = true;
+}
+
+void BrickField::Place(int row, int col, Rect rect, int element, int hitPoints) {
+    const int cell = CellIndex(row, col);
+    if (IsActive(cell)) {
+        SetMaskBit(MutableElementMask(elements_[cell]), cell, false);
+        elementCounts_[elements_[cell] + 1] -= 1;
+    } else {
+        activeCount_ += 1;
+        SetDiagonalBits(row, col, true);
+    }
+    activeMask_[cell >> 6] |= std::uint64_t{1} << (cell & 63);
+    SetMaskBit(MutableElementMask(element), cell, true);
+    elementCounts_[element + 1] += 1;
+    SetMaskBit(frozenMask_.data(), cell, false);
+    rects_[cell] = rect;
+    elements_[cell] = static_cast<std::int8_t>(element);
+    hitPoints_[cell] = static_cast<std::int8_t>(hitPoints);
+    flags_[cell] = 0;
+    originalElements_[cell] = -1;
+    MarkDirty(cell);
+}
+
+void BrickField::Destroy(int cell) {
+    if (IsActive(cell)) {
+        SetMaskBit(MutableElementMask(elements_[cell]), cell, false);
+        elementCounts_[elements_[cell] + 1] -= 1;
+        activeCount_ -= 1;
+        SetDiagonalBits(RowOf(cell), ColOf(cell), false);
+    }
+    activeMask_[cell >> 6] &= ~(std::uint64_t{1} << (cell & 63));
+    SetMaskBit(frozenMask_.data(), cell, false);
+    elements_[cell] = -1;
+    hitPoints_[cell] = 0;
+    flags_[cell] = 0;
+    MarkDirty(cell);
+}
+
+void BrickField::SetElement(int cell, int element) {
+    if (IsActive(cell)) {
+        SetMaskBit(MutableElementMask(elements_[cell]), cell, false);
+        SetMaskBit(MutableElementMask(element), cell, true);
+        elementCounts_[elements_[cell] + 1] -= 1;
+        elementCounts_[element + 1] += 1;
+    }
+    elements_[cell] = static_cast<std::int8_t>(element);
+    MarkDirty(cell);
+}
+
+void BrickField::SetLayout(Vec2 origin, Vec2 pitch) {
+    layoutOrigin_ = origin;
+    layoutPitch_ = pitch;
+}
+
+BrickField::CellRange BrickField::CellsOverlapping(const Rect& box) const {
+    if (layoutPitch_.x <= 0.0f || layoutPitch_.y <= 0.0f) {
+        return CellRange{0, rows_, 0, cols_};
+    }
+
+    // One extra slot on each side absorbs rounding in the placed rects.
+    auto span = [](float min, float max, float origin, float pitch, int count, int& begin, int& end) {
+        float first = std::floor((min - origin) / pitch) - 1.0f;
+        float last = std::floor((max - origin) / pitch) + 2.0f;
+        begin = static_cast<int>(std::clamp(first, 0.0f, static_cast<float>(count)));
+        end = static_cast<int>(std::clamp(last, 0.0f, static_cast<float>(count)));
+    };
+    CellRange range{};
+    span(box.y, box.y + box.height, layoutOrigin_.y, layoutPitch_.y, rows_, range.rowBegin, range.rowEnd);
+    span(box.x, box.x + box.width, layoutOrigin_.x, layoutPitch_.x, cols_, range.colBegin, range.colEnd);
+    return range;
+}
+
+float BrickField::LayoutBottom() const {
+    if (layoutPitch_.x <= 0.0f || layoutPitch_.y <= 0.0f) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return layoutOrigin_.y + static_cast<float>(rows_) * layoutPitch_.y;
+}
+
+int BrickField::NextActive(int fromCell, int endCell) const {
+    if (fromCell >= endCell) {
+        return -1;
+    }
+    const int lastWord = (endCell - 1) >> 6;
+    int word = fromCell >> 6;
+
+    std::uint64_t bits = activeMask_[word] & (~std::uint64_t{0} << (fromCell & 63));
+    while (bits == 0) {
+        if (++word > lastWord) {
+            return -1;
+        }
+        bits = activeMask_[word];
+    }
+    const int cell = (word << 6) + std::countr_zero(bits);
+    return cell < endCell ? cell : -1;
+}
+
+int BrickField::NextOnDiagonal(int row, int col, int rowStep, int colStep) const {
+    if (!InBounds(row, col)) {
+        return -1;
+    }
+    const std::uint64_t* diagonal = diagonals_.data() + DiagonalOffset(row, col, rowStep == colStep);
+    int found = 0;
+    if (rowStep > 0) {
+        const int from = row + 1;
+        int word = from >> 6;
+        if (word >= diagonalWords_) {
+            return -1;
+        }
+        std::uint64_t bits = diagonal[word] & (~std::uint64_t{0} << (from & 63));
+        while (bits == 0) {
+            if (++word >= diagonalWords_) {
+                return -1;
+            }
+            bits = diagonal[word];
+        }
+        found = (word << 6) + std::countr_zero(bits);
+    } else {
+        if (row == 0) {
+            return -1;
+        }
+        const int from = row - 1;
+        int word = from >> 6;
+        std::uint64_t bits = diagonal[word] & (~std::uint64_t{0} >> (63 - (from & 63)));
+        while (bits == 0) {
+            if (--word < 0) {
+                return -1;
+            }
+            bits = diagonal[word];
+        }
+        found = (word << 6) + 63 - std::countl_zero(bits);
+    }
+    return CellIndex(found, col + (found - row) * rowStep * colStep);
+}
+
+int BrickField::FillCluster(const std::uint64_t* candidates, int startCell) {
+    const int words = stride_ / 64;
+    std::fill(cluster_.begin() + clusterRowBegin_ * words, cluster_.begin() + clusterRowEnd_ * words, 0);
+
+    const int startRow = RowOf(startCell);
+    clusterRowBegin_ = startRow;
+    clusterRowEnd_ = startRow;
+    if (((candidates[startCell >> 6] >> (startCell & 63)) & 1u) == 0) {
+        return 0;
+    }
+
+    // Seed the start row, then sweep down and up over the rows the cluster spans (plus
+    // one on each side) until no row grows. Each row fill handles a whole horizontal
+    // run in a few word operations, so most clusters settle in one or two sweeps.
+    std::uint64_t* seeds = clusterSeeds_.data();
+    std::fill(seeds, seeds + words, 0);
+    seeds[(startCell >> 6) - startRow * words] = std::uint64_t{1} << (startCell & 63);
+    FillRow(&cluster_[startRow * words], seeds, &candidates[startRow * words], words);
+    clusterRowEnd_ = startRow + 1;
+
+    // A row only ever holds a fill result, so it grows exactly when its neighbours add
+    // new seeds to it.
+    auto growRow = [&](int row) {
+        std::uint64_t* current = &cluster_[row * words];
+        const std::uint64_t* above = row > 0 ? &cluster_[(row - 1) * words] : nullptr;
+        const std::uint64_t* below = row + 1 < rows_ ? &cluster_[(row + 1) * words] : nullptr;
+        bool grew = false;
+        for (int w = 0; w < words; ++w) {
+            std::uint64_t neighbours = (above ? above[w] : 0) | (below ? below[w] : 0);
+            seeds[w] = current[w] | (neighbours & candidates[row * words + w]);
+            grew = grew || seeds[w] != current[w];
+        }
+        if (!grew) {
+            return false;
+        }
+        FillRow(current, seeds, &candidates[row * words], words);
+        clusterRowBegin_ = std::min(clusterRowBegin_, row);
+        clusterRowEnd_ = std::max(clusterRowEnd_, row + 1);
+        return true;
+    };
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int row = std::max(clusterRowBegin_ - 1, 0); row < std::min(clusterRowEnd_ + 1, rows_); ++row) {
+            changed = growRow(row) || changed;
+        }
+        for (int row = std::min(clusterRowEnd_, rows_ - 1); row >= std::max(clusterRowBegin_ - 1, 0); --row) {
+            changed = growRow(row) || changed;
+        }
+    }
+
+    int count = 0;
+    for (int w = clusterRowBegin_ * words; w < clusterRowEnd_ * words; ++w) {
+        count += std::popcount(cluster_[w]);
+    }
+    return count;
+}
+
+int BrickField::NextInCluster(int fromCell) const {
+    const int words = stride_ / 64;
+    const int endWord = clusterRowEnd_ * words;
+    int word = std::max(fromCell >> 6, clusterRowBegin_ * words);
+    if (word >= endWord) {
+        return -1;
+    }
+
+    std::uint64_t bits = cluster_[word];
+    if (word == fromCell >> 6) {
+        bits &= ~std::uint64_t{0} << (fromCell & 63);
+    }
+    while (bits == 0) {
+        if (++word >= endWord) {
+            return -1;
+        }
+        bits = cluster_[word];
+    }
+    return (word << 6) + std::countr_zero(bits);
+}
+
+template <typename CellFn>
+void BrickField::ForEachClusterCell(CellFn&& cellFn) {
+    const int words = stride_ / 64;
+    for (int w = clusterRowBegin_ * words; w < clusterRowEnd_ * words; ++w) {
+        std::uint64_t bits = cluster_[w];
+        const int base = w << 6;
+        if (bits == ~std::uint64_t{0}) {
+            // Solid words are common in big clusters; a straight loop vectorizes.
+            for (int i = 0; i < 64; ++i) {
+                cellFn(base + i);
+            }
+            continue;
+        }
+        while (bits != 0) {
+            cellFn(base + std::countr_zero(bits));
+            bits &= bits - 1;
+        }
+    }
+}
+
+void BrickField::FreezeCluster() {
+    ForEachClusterCell([this](int cell) {
+        originalElements_[cell] = elements_[cell];
+        flags_[cell] |= kFlagFrozen;
+    });
+    const int words = stride_ / 64;
+    for (int w = clusterRowBegin_ * words; w < clusterRowEnd_ * words; ++w) {
+        frozenMask_[w] |= cluster_[w];
+        dirtyMask_[w] |= cluster_[w];
+    }
+}
+
+void BrickField::ThawCluster(int element) {
+    const std::int8_t value = static_cast<std::int8_t>(element);
+    ForEachClusterCell([this, value](int cell) {
+        elementCounts_[elements_[cell] + 1] -= 1;
+        elements_[cell] = value;
+        flags_[cell] &= ~kFlagFrozen;
+    });
+    const int words = stride_ / 64;
+    const std::size_t wordCount = activeMask_.size();
+    std::uint64_t* target = MutableElementMask(element);
+    int thawed = 0;
+    for (int w = clusterRowBegin_ * words; w < clusterRowEnd_ * words; ++w) {
+        const std::uint64_t bits = cluster_[w];
+        frozenMask_[w] &= ~bits;
+        dirtyMask_[w] |= bits;
+        for (int e = 0; e <= kElementCount; ++e) {
+            elementMasks_[e * wordCount + w] &= ~bits;
+        }
+        target[w] |= bits;
+        thawed += std::popcount(bits);
+    }
+    elementCounts_[element + 1] += thawed;
+}
+
+int BrickField::NextDirty(int fromCell) const {
+    const int wordCount = static_cast<int>(dirtyMask_.size());
+    int word = fromCell >> 6;
+    if (word >= wordCount) {
+        return -1;
+    }
+    std::uint64_t bits = dirtyMask_[word] & (~std::uint64_t{0} << (fromCell & 63));
+    while (bits == 0) {
+        if (++word >= wordCount) {
+            return -1;
+        }
+        bits = dirtyMask_[word];
+    }
+    return (word << 6) + std::countr_zero(bits);
+}
+
+void BrickField::ClearDirty() {
+    std::fill(dirtyMask_.begin(), dirtyMask_.end(), 0);
+    allDirty_ = false;
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "Elements.h"
+#include "SimTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+// Structure-of-arrays brick storage for the playfield grid.
+//
+// Every grid cell owns a slot, addressed as row * Stride() + col. Rows are padded
+// to a whole number of 64-bit words so the active bitmask lines up with the grid;
+// empty and destroyed cells are simply inactive. The collision sweep only touches
+// the active mask and rects, the reactions touch elements and hit points, and the
+// cold per-brick flags are kept out of the way for Draw.
+//
+// Per-element and frozen bitmasks (same layout as the active mask) let cluster
+// reactions flood-fill whole rows at a time; see FillCluster. Each diagonal also keeps
+// a row-indexed occupancy bitset so the next live brick along it is one bit scan away.
+//
+// Every change to how a cell looks (placed, destroyed, recoloured, cracked, frozen) is
+// flagged in a dirty mask, so a renderer caching the field redraws only those cells.
+class BrickField {
+public:
+    // Half-open block of grid cells.
+    struct CellRange {
+        int rowBegin;
+        int rowEnd;
+        int colBegin;
+        int colEnd;
+    };
+
+    void Reset(int rows, int cols);
+    // Declares where the grid sits in the world: cell (row, col) lies inside the slot
+    // starting at origin + (col, row) * pitch. Bricks must be placed inside their slot.
+    // Until a layout is set (and after Reset) every cell counts as overlapping.
+    void SetLayout(Vec2 origin, Vec2 pitch);
+    // Cells whose slot may overlap the box; the broadphase for the collision sweep.
+    CellRange CellsOverlapping(const Rect& box) const;
+    // Lowest world y any laid-out brick can reach (infinity without a layout).
+    float LayoutBottom() const;
+    Vec2 LayoutOrigin() const { return layoutOrigin_; }
+    Vec2 LayoutPitch() const { return layoutPitch_; }
+
+    void Place(int row, int col, Rect rect, int element, int hitPoints);
+    void Destroy(int cell);
+
+    int Rows() const { return rows_; }
+    int Cols() const { return cols_; }
+    int Stride() const { return stride_; }
+    int CellCount() const { return rows_ * stride_; }
+
+    bool InBounds(int row, int col) const { return row >= 0 && row < rows_ && col >= 0 && col < cols_; }
+    int CellIndex(int row, int col) const { return row * stride_ + col; }
+    int RowOf(int cell) const { return cell / stride_; }
+    int ColOf(int cell) const { return cell % stride_; }
+
+    bool IsActive(int cell) const { return (activeMask_[cell >> 6] >> (cell & 63)) & 1u; }
+    // Returns the first active cell at or after fromCell (and before endCell), or -1
+    // when there are none.
+    int NextActive(int fromCell) const { return NextActive(fromCell, CellCount()); }
+    int NextActive(int fromCell, int endCell) const;
+    // Returns the first active cell past (row, col) going diagonally by (rowStep, colStep),
+    // each +1 or -1, or -1 when the diagonal has none. Cost follows the bitset words
+    // crossed, not the cells.
+    int NextOnDiagonal(int row, int col, int rowStep, int colStep) const;
+    // Live brick counts, kept up to date by every mutator.
+    int CountActive() const { return activeCount_; }
+    int CountElement(int element) const { return elementCounts_[element + 1]; }
+
+    const Rect& BrickRect(int cell) const { return rects_[cell]; }
+
+    int Element(int cell) const { return elements_[cell]; }
+    void SetElement(int cell, int element);
+
+    int HitPoints(int cell) const { return hitPoints_[cell]; }
+    void SetHitPoints(int cell, int hitPoints) { hitPoints_[cell] = static_cast<std::int8_t>(hitPoints); }
+
+    bool IsCracked(int cell) const { return (flags_[cell] & kFlagCracked) != 0; }
+    void SetCracked(int cell, bool cracked) {
+        SetFlag(cell, kFlagCracked, cracked);
+        MarkDirty(cell);
+    }
+
+    bool IsFrozen(int cell) const { return (flags_[cell] & kFlagFrozen) != 0; }
+    void SetFrozen(int cell, bool frozen) {
+        SetFlag(cell, kFlagFrozen, frozen);
+        SetMaskBit(frozenMask_.data(), cell, frozen);
+        MarkDirty(cell);
+    }
+
+    int OriginalElement(int cell) const { return originalElements_[cell]; }
+    void SetOriginalElement(int cell, int element) { originalElements_[cell] = static_cast<std::int8_t>(element); }
+
+    // Active cells of the given element (kColorIndexNone for neutral bricks).
+    const std::uint64_t* ElementMask(int element) const {
+        return elementMasks_.data() + static_cast<std::size_t>(element + 1) * activeMask_.size();
+    }
+    // Active cells that are frozen.
+    const std::uint64_t* FrozenMask() const { return frozenMask_.data(); }
+
+    // Flood-fills the 4-connected group of cells set in `candidates` (laid out like the
+    // masks above) that contains startCell. Returns the number of cells in the group,
+    // which can then be walked with NextInCluster until the next fill. Allocation-free.
+    int FillCluster(const std::uint64_t* candidates, int startCell);
+    // Returns the first cluster cell at or after fromCell, or -1 when there are none.
+    int NextInCluster(int fromCell) const;
+    // Freezes every cell of the last fill, remembering its element for the thaw.
+    void FreezeCluster();
+    // Unfreezes every cell of the last fill and turns it into the given element.
+    void ThawCluster(int element);
+
+    // Cells that changed look since the last ClearDirty. After Reset the whole field
+    // counts as changed and AllDirty is true until the next ClearDirty.
+    bool AllDirty() const { return allDirty_; }
+    int NextDirty(int fromCell) const;
+    void ClearDirty();
+
+private:
+    static constexpr std::uint8_t kFlagCracked = 1u << 0;
+    static constexpr std::uint8_t kFlagFrozen = 1u << 1;
+
+    void SetFlag(int cell, std::uint8_t flag, bool value) {
+        flags_[cell] = value ? (flags_[cell] | flag) : (flags_[cell] & ~flag);
+    }
+    void MarkDirty(int cell) { dirtyMask_[cell >> 6] |= std::uint64_t{1} << (cell & 63); }
+    static void SetMaskBit(std::uint64_t* mask, int cell, bool value) {
+        const std::uint64_t bit = std::uint64_t{1} << (cell & 63);
+        mask[cell >> 6] = value ? (mask[cell >> 6] | bit) : (mask[cell >> 6] & ~bit);
+    }
+    // Calls cellFn for every cell of the last FillCluster result.
+    template <typename CellFn>
+    void ForEachClusterCell(CellFn&& cellFn);
+    std::uint64_t* MutableElementMask(int element) {
+        return elementMasks_.data() + static_cast<std::size_t>(element + 1) * activeMask_.size();
+    }
+    // Diagonals running down-right are numbered col - row + rows - 1 and come first,
+    // then the down-left ones, numbered row + col; bit `row` marks the cell in that row.
+    std::size_t DiagonalOffset(int row, int col, bool downRight) const {
+        const int diagonal = downRight ? col - row + rows_ - 1 : rows_ + cols_ - 1 + row + col;
+        return static_cast<std::size_t>(diagonal) * diagonalWords_;
+    }
+    void SetDiagonalBits(int row, int col, bool value) {
+        SetMaskBit(diagonals_.data() + DiagonalOffset(row, col, true), row, value);
+        SetMaskBit(diagonals_.data() + DiagonalOffset(row, col, false), row, value);
+    }
+
+    int rows_{0};
+    int cols_{0};
+    int stride_{0};
+    Vec2 layoutOrigin_{};
+    Vec2 layoutPitch_{};
+    int activeCount_{0};
+    int elementCounts_[kElementCount + 1]{};  // neutral first
+
+    // Hot: read by the collision sweep every frame.
+    std::vector<std::uint64_t> activeMask_;
+    std::vector<Rect> rects_;
+
+    // Warm: read and written by the element reactions.
+    std::vector<std::int8_t> elements_;
+    std::vector<std::int8_t> hitPoints_;
+    std::vector<std::uint64_t> elementMasks_;  // kElementCount + 1 masks, neutral first
+    std::vector<std::uint64_t> frozenMask_;
+    std::vector<std::uint64_t> diagonals_;  // 2 * (rows + cols - 1) diagonals of diagonalWords_
+    int diagonalWords_{0};
+
+    // Scratch for FillCluster; only rows clusterRowBegin_..clusterRowEnd_ may be non-zero.
+    std::vector<std::uint64_t> cluster_;
+    std::vector<std::uint64_t> clusterSeeds_;  // one row
+    int clusterRowBegin_{0};
+    int clusterRowEnd_{0};
+
+    // Cold: presentation state only consulted when drawing or thawing.
+    std::vector<std::uint8_t> flags_;
+    std::vector<std::int8_t> originalElements_;
+    std::vector<std::uint64_t> dirtyMask_;
+    bool allDirty_{true};
+};
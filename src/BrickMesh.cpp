@@ -0,0 +1,210 @@
+#include "BrickMesh.h"
+
+#include <raymath.h>
+
+#include <algorithm>
+
+#include "BrickPalette.h"
+
+namespace {
+// Past this many separate changed runs in one tile, one upload spanning them is cheaper.
+constexpr std::size_t kMaxUploadRuns = 16;
+
+constexpr int kFloatsPerCell = BrickMesh::kVerticesPerCell * 3;
+constexpr int kBytesPerCell = BrickMesh::kVerticesPerCell * 4;
+
+// top drawn with its alpha over an opaque bottom.
+Color BlendOver(Color top, Color bottom) {
+    const int alpha = top.a;
+    auto mix = [alpha](unsigned char over, unsigned char under) {
+        return static_cast<unsigned char>((over * alpha + under * (255 - alpha) + 127) / 255);
+    };
+    return Color{mix(top.r, bottom.r), mix(top.g, bottom.g), mix(top.b, bottom.b), 255};
+}
+
+// Two triangles, wound the way raylib's own rectangles are so back-face culling keeps them.
+void WriteQuad(float* positions, unsigned char* colors, float x, float y, float width, float height, Color color) {
+    const float corners[6][2] = {
+        {x, y}, {x, y + height}, {x + width, y + height}, {x, y}, {x + width, y + height}, {x + width, y},
+    };
+    for (const auto& corner : corners) {
+        *positions++ = corner[0];
+        *positions++ = corner[1];
+        *positions++ = 0.0f;
+        *colors++ = color.r;
+        *colors++ = color.g;
+        *colors++ = color.b;
+        *colors++ = color.a;
+    }
+}
+
+bool Overlaps(const Rect& a, const Rect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+}  // namespace
+
+bool BrickMesh::Update(const BrickField& bricks) {
+    uploadedVertices_ = 0;
+    const int rows = bricks.Rows();
+    const int cols = bricks.Cols();
+    if (rows == 0 || cols == 0 || rows * cols > kMaxCells) {
+        Unload();
+        return false;
+    }
+
+    if (!ready_ || rows != rows_ || cols != cols_) {
+        Unload();
+        rows_ = rows;
+        cols_ = cols;
+        tilesAcross_ = (cols + kTileSide - 1) / kTileSide;
+        tiles_.reserve(static_cast<std::size_t>((rows + kTileSide - 1) / kTileSide) * tilesAcross_);
+        const Vec2 origin = bricks.LayoutOrigin();
+        const Vec2 pitch = bricks.LayoutPitch();
+        for (int rowBegin = 0; rowBegin < rows; rowBegin += kTileSide) {
+            for (int colBegin = 0; colBegin < cols; colBegin += kTileSide) {
+                const int tileRows = std::min(kTileSide, rows - rowBegin);
+                const int tileCols = std::min(kTileSide, cols - colBegin);
+                const std::size_t cells = static_cast<std::size_t>(tileRows) * tileCols;
+                tiles_.emplace_back();
+                Tile& tile = tiles_.back();
+                tile.rowBegin = rowBegin;
+                tile.colBegin = colBegin;
+                tile.cols = tileCols;
+                tile.bounds = Rect{origin.x + static_cast<float>(colBegin) * pitch.x,
+                                   origin.y + static_cast<float>(rowBegin) * pitch.y,
+                                   static_cast<float>(tileCols) * pitch.x, static_cast<float>(tileRows) * pitch.y};
+                tile.positions.assign(cells * kFloatsPerCell, 0.0f);
+                tile.colors.assign(cells * kBytesPerCell, 0);
+                tile.active.assign(cells, 0);
+                for (int row = rowBegin; row < rowBegin + tileRows; ++row) {
+                    for (int col = colBegin; col < colBegin + tileCols; ++col) {
+                        WriteCell(bricks, tile, row, col);
+                    }
+                }
+                tile.mesh.vertexCount = static_cast<int>(cells) * kVerticesPerCell;
+                tile.mesh.triangleCount = tile.mesh.vertexCount / 3;
+                tile.mesh.vertices = tile.positions.data();
+                tile.mesh.colors = tile.colors.data();
+                UploadMesh(&tile.mesh, true);
+                uploadedVertices_ += tile.mesh.vertexCount;
+            }
+        }
+        material_ = LoadMaterialDefault();
+        ready_ = true;
+        return true;
+    }
+
+    if (bricks.AllDirty()) {
+        for (Tile& tile : tiles_) {
+            const int tileRows = static_cast<int>(tile.active.size()) / tile.cols;
+            for (int row = tile.rowBegin; row < tile.rowBegin + tileRows; ++row) {
+                for (int col = tile.colBegin; col < tile.colBegin + tile.cols; ++col) {
+                    WriteCell(bricks, tile, row, col);
+                }
+            }
+            Upload(tile, 0, static_cast<int>(tile.active.size()));
+        }
+        return true;
+    }
+
+    runs_.clear();
+    for (int cell = bricks.NextDirty(0); cell != -1; cell = bricks.NextDirty(cell + 1)) {
+        const int row = bricks.RowOf(cell);
+        const int col = bricks.ColOf(cell);
+        if (col >= cols_) {
+            continue;
+        }
+        const int tileIndex = TileOf(row, col);
+        Tile& tile = tiles_[tileIndex];
+        WriteCell(bricks, tile, row, col);
+        const int local = (row - tile.rowBegin) * tile.cols + col - tile.colBegin;
+        if (!runs_.empty() && runs_.back().tile == tileIndex && runs_.back().end == local) {
+            runs_.back().end = local + 1;
+        } else {
+            runs_.push_back(Run{tileIndex, local, local + 1});
+        }
+    }
+    // Dirty cells come in row order, which interleaves the tiles of a band.
+    std::stable_sort(runs_.begin(), runs_.end(), [](const Run& a, const Run& b) { return a.tile < b.tile; });
+    for (std::size_t first = 0; first < runs_.size();) {
+        std::size_t last = first;
+        while (last + 1 < runs_.size() && runs_[last + 1].tile == runs_[first].tile) {
+            last += 1;
+        }
+        Tile& tile = tiles_[runs_[first].tile];
+        if (last - first + 1 > kMaxUploadRuns) {
+            Upload(tile, runs_[first].begin, runs_[last].end);
+        } else {
+            for (std::size_t i = first; i <= last; ++i) {
+                Upload(tile, runs_[i].begin, runs_[i].end);
+            }
+        }
+        first = last + 1;
+    }
+    return true;
+}
+
+void BrickMesh::WriteCell(const BrickField& bricks, Tile& tile, int row, int col) {
+    const int local = (row - tile.rowBegin) * tile.cols + col - tile.colBegin;
+    float* positions = tile.positions.data() + static_cast<std::size_t>(local) * kFloatsPerCell;
+    unsigned char* colors = tile.colors.data() + static_cast<std::size_t>(local) * kBytesPerCell;
+    const int cell = bricks.CellIndex(row, col);
+    const bool active = bricks.IsActive(cell);
+    tile.live += static_cast<int>(active) - tile.active[local];
+    tile.active[local] = static_cast<std::uint8_t>(active);
+    if (!active) {
+        std::fill(positions, positions + kFloatsPerCell, 0.0f);
+        return;
+    }
+
+    const Rect rect = bricks.BrickRect(cell);
+    const BrickLook look = LookOfBrick(bricks, cell);
+    if (!look.outlined) {
+        WriteQuad(positions, colors, rect.x, rect.y, rect.width, rect.height, look.fill);
+        std::fill(positions + kFloatsPerCell / 2, positions + kFloatsPerCell, 0.0f);
+        return;
+    }
+    const float inset = std::min({kBrickOutlineWidth, rect.width * 0.5f, rect.height * 0.5f});
+    WriteQuad(positions, colors, rect.x, rect.y, rect.width, rect.height, BlendOver(look.outline, look.fill));
+    WriteQuad(positions + kFloatsPerCell / 2, colors + kBytesPerCell / 2, rect.x + inset, rect.y + inset,
+              rect.width - 2.0f * inset, rect.height - 2.0f * inset, look.fill);
+}
+
+void BrickMesh::Upload(Tile& tile, int begin, int end) {
+    const int cells = end - begin;
+    UpdateMeshBuffer(tile.mesh, 0, tile.positions.data() + static_cast<std::size_t>(begin) * kFloatsPerCell,
+                     cells * kFloatsPerCell * static_cast<int>(sizeof(float)),
+                     begin * kFloatsPerCell * static_cast<int>(sizeof(float)));
+    UpdateMeshBuffer(tile.mesh, 3, tile.colors.data() + static_cast<std::size_t>(begin) * kBytesPerCell,
+                     cells * kBytesPerCell, begin * kBytesPerCell);
+    uploadedVertices_ += cells * kVerticesPerCell;
+}
+
+int BrickMesh::Draw(Rect view, long long& vertices) const {
+    int drawCalls = 0;
+    const Matrix identity = MatrixIdentity();
+    for (const Tile& tile : tiles_) {
+        if (tile.live == 0 || !Overlaps(tile.bounds, view)) {
+            continue;
+        }
+        DrawMesh(tile.mesh, material_, identity);
+        drawCalls += 1;
+        vertices += tile.mesh.vertexCount;
+    }
+    return drawCalls;
+}
+
+void BrickMesh::Unload() {
+    if (!ready_) {
+        return;
+    }
+    for (Tile& tile : tiles_) {
+        // The vertex arrays belong to the tile, not to raylib.
+        tile.mesh.vertices = nullptr;
+        tile.mesh.colors = nullptr;
+        UnloadMesh(tile.mesh);
+    }
+    tiles_.clear();
+    UnloadMaterial(material_);
+    ready_ = false;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "BrickField.h"
+
+// The brick field as dynamic meshes, one per 64x64-cell tile. Every cell owns a fixed
+// run of vertices in its tile (an outline quad with the fill quad inset over it; empty
+// cells collapse to a point), so the cells a step changed are rewritten and uploaded in
+// place and nothing else is touched. Outlines are blended into their colour on the CPU,
+// which keeps the meshes opaque. Drawing submits one DrawMesh per tile that overlaps the
+// view and still holds a brick.
+class BrickMesh {
+public:
+    // Larger boards would need more than ~200 MB of vertex data.
+    static constexpr int kMaxCells = 1 << 20;
+    static constexpr int kVerticesPerCell = 12;
+    static constexpr int kTileSide = 64;
+
+    // Rebuilds the meshes when the field was reset or resized and patches the changed
+    // cells otherwise; returns false if the board is too big. Leaves the field's change
+    // flags for the caller to clear.
+    bool Update(const BrickField& bricks);
+    // Returns the draw calls made; adds the vertices they submitted to vertices.
+    int Draw(Rect view, long long& vertices) const;
+    void Unload();
+
+    bool Ready() const { return ready_; }
+    // Vertices sent to the GPU by the last Update.
+    int UploadedVertices() const { return uploadedVertices_; }
+
+private:
+    struct Tile {
+        Mesh mesh{};
+        int rowBegin{0};
+        int colBegin{0};
+        int cols{0};
+        Rect bounds{};
+        int live{0};  // cells holding a brick
+        std::vector<float> positions;       // x, y, z per vertex
+        std::vector<unsigned char> colors;  // r, g, b, a per vertex
+        std::vector<std::uint8_t> active;   // per cell, as last written
+    };
+    // Cells [begin, end) of one tile, in its local order.
+    struct Run {
+        int tile;
+        int begin;
+        int end;
+    };
+
+    int TileOf(int row, int col) const { return (row / kTileSide) * tilesAcross_ + col / kTileSide; }
+    void WriteCell(const BrickField& bricks, Tile& tile, int row, int col);
+    void Upload(Tile& tile, int begin, int end);
+
+    std::vector<Tile> tiles_;
+    Material material_{};
+    bool ready_{false};
+    int rows_{0};
+    int cols_{0};
+    int tilesAcross_{0};
+    int uploadedVertices_{0};
+    std::vector<Run> runs_;  // the pending upload
+};
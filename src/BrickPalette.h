@@ -0,0 +1,59 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <algorithm>
+
+#include "BrickField.h"
+#include "Elements.h"
+
+// Element colours shared by everything that draws bricks, balls and the paddle.
+inline constexpr Color kBrickPalette[] = {
+    {255, 102, 0, 255},   // orange-red
+    {0, 112, 221, 255},   // blue
+    {0, 191, 165, 255},   // teal-green
+    {196, 120, 255, 255}, // light purple
+    {173, 216, 230, 255}, // light blue/white
+};
+static_assert(sizeof(kBrickPalette) / sizeof(kBrickPalette[0]) == kElementCount);
+
+inline constexpr Color kNeutralBrickColor = {255, 221, 0, 255};  // yellow
+
+inline Color ElementColor(int element, Color neutral) {
+    if (element >= 0 && element < kElementCount) {
+        return kBrickPalette[element];
+    }
+    return neutral;
+}
+
+inline Color DarkenColor(Color color) {
+    return Color{
+        static_cast<unsigned char>(std::clamp<int>(static_cast<int>(color.r * 0.65f), 0, 255)),
+        static_cast<unsigned char>(std::clamp<int>(static_cast<int>(color.g * 0.65f), 0, 255)),
+        static_cast<unsigned char>(std::clamp<int>(static_cast<int>(color.b * 0.65f), 0, 255)),
+        color.a,
+    };
+}
+
+// How one brick is drawn: a solid fill and, for cracked or frozen bricks, a translucent
+// 2 px outline just inside its edge.
+struct BrickLook {
+    Color fill;
+    Color outline;
+    bool outlined;
+};
+
+inline BrickLook LookOfBrick(const BrickField& bricks, int cell) {
+    const bool cracked = bricks.IsCracked(cell);
+    const bool frozen = bricks.IsFrozen(cell);
+    const Color baseColor = frozen ? WHITE : ElementColor(bricks.Element(cell), kNeutralBrickColor);
+    BrickLook look{(cracked && !frozen) ? DarkenColor(baseColor) : baseColor, BLANK, cracked || frozen};
+    if (cracked) {
+        look.outline = Fade(WHITE, 0.6f);
+    } else if (frozen) {
+        look.outline = Fade(BLUE, 0.5f);
+    }
+    return look;
+}
+
+inline constexpr float kBrickOutlineWidth = 2.0f;
@@ -0,0 +1,142 @@
+#include "BrickReactions.h"
+
+#include "Elements.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+int FreezeConnectedBricks(BrickField& bricks, int startRow, int startCol, int targetColorIndex) {
+    if (!bricks.InBounds(startRow, startCol)) {
+        return 0;
+    }
+    int frozenCount = bricks.FillCluster(bricks.ElementMask(targetColorIndex), bricks.CellIndex(startRow, startCol));
+    bricks.FreezeCluster();
+    return frozenCount;
+}
+
+void ThawFrozenCluster(BrickField& bricks, int startRow, int startCol) {
+    if (!bricks.InBounds(startRow, startCol)) {
+        return;
+    }
+    bricks.FillCluster(bricks.FrozenMask(), bricks.CellIndex(startRow, startCol));
+    bricks.ThawCluster(kColorIndexBlue);
+}
+
+void ScheduleSurgeChain(ReactionQueue& events, const BrickField& bricks, int startRow, int startCol, int maxTargets,
+                        float stepDelay, int element) {
+    const std::pair<int, int> directions[] = {{1, 1}, {-1, -1}, {1, -1}, {-1, 1}};
+    int scheduled = 0;
+    for (const auto& dir : directions) {
+        int row = startRow;
+        int col = startCol;
+        for (int cell = bricks.NextOnDiagonal(row, col, dir.first, dir.second); cell != -1;
+             cell = bricks.NextOnDiagonal(row, col, dir.first, dir.second)) {
+            row = bricks.RowOf(cell);
+            col = bricks.ColOf(cell);
+            const int distance = std::abs(row - startRow);
+            events.Schedule(ReactionEvent{row, col, ReactionKind::SurgeChain, 0, AoEShape::Square, element},
+                            stepDelay * static_cast<float>(distance));
+            scheduled += 1;
+            if (scheduled >= maxTargets) {
+                return;
+            }
+        }
+    }
+}
+
+void CreateBricks(BrickField& bricks, Rng& rng, const SimulationConfig& config) {
+    const SpawnWeights& weights = config.spawn;
+    const int rows = config.brickRows;
+    const int cols = config.brickCols;
+    bricks.Reset(rows, cols);
+
+    const float spacing = config.brickSpacing;
+    const float brickHeight = config.brickHeight;
+    float brickWidth = config.brickWidth;
+    if (brickWidth <= 0.0f) {
+        float totalSpacingX = (cols + 1) * spacing;
+        float availableWidth = config.worldWidth - totalSpacingX;
+        brickWidth = availableWidth / cols;
+    }
+    bricks.SetLayout({spacing, config.brickTopOffset}, {brickWidth + spacing, brickHeight + spacing});
+    for (int row = 0; row < rows; ++row) {
+        int col = 0;
+        while (col < cols) {
+            int remaining = cols - col;
+            int chunkSize = rng.Range(weights.minChunk, weights.maxChunk);
+            if (chunkSize > remaining) {
+                chunkSize = remaining;
+            }
+
+            int colorIdx = -1;  // default to yellow
+
+            int roll = rng.Range(1, 100);
+            if (roll <= weights.neutralPercent) {
+                colorIdx = -1;
+            } else if (roll <= weights.neutralPercent + weights.greenPercent) {
+                colorIdx = kColorIndexGreen;
+            } else {
+                static const int kRemainingColors[] = {
+                    kColorIndexRed,
+                    kColorIndexBlue,
+                    kColorIndexPurple,
+                    kColorIndexLightBlue,
+                };
+                // The rest of the roll is split evenly across the four remaining elements.
+                int remainder = roll - weights.neutralPercent - weights.greenPercent;  // 1-36 by default
+                int remainderSpan = std::max(1, 100 - weights.neutralPercent - weights.greenPercent);
+                int index = (remainder - 1) * 4 / remainderSpan;
+                if (index < 0) {
+                    index = 0;
+                } else if (index > 3) {
+                    index = 3;
+                }
+                colorIdx = kRemainingColors[index];
+            }
+
+            for (int i = 0; i < chunkSize; ++i) {
+                int currentCol = col + i;
+                float x = spacing + currentCol * (brickWidth + spacing);
+                float y = config.brickTopOffset + row * (brickHeight + spacing);
+
+                bool hasGap = rng.Range(0, 99) < weights.gapPercent;
+                if (hasGap) {
+                    continue;
+                }
+
+                bricks.Place(row, currentCol, {x, y, brickWidth, brickHeight}, colorIdx, 2);
+            }
+
+            col += chunkSize;
+        }
+    }
+}
+
+int QueueOverloadedAoE(ReactionCascade& cascade, const BrickField& bricks, int centerRow, int centerCol, int radius,
+                       AoEShape shape, int element) {
+    int queued = 0;
+    const int rowBegin = std::max(centerRow - radius, 0);
+    const int rowEnd = std::min(centerRow + radius + 1, bricks.Rows());
+    for (int row = rowBegin; row < rowEnd; ++row) {
+        const int dRow = std::abs(row - centerRow);
+        int reach = radius;
+        if (shape == AoEShape::Diamond) {
+            reach = radius - dRow;
+        } else if (shape == AoEShape::Circle) {
+            reach = static_cast<int>(std::sqrt(static_cast<double>(radius * radius - dRow * dRow)));
+        }
+        const int colBegin = std::max(centerCol - reach, 0);
+        const int colEnd = std::min(centerCol + reach + 1, bricks.Cols());
+        if (colBegin >= colEnd) {
+            continue;
+        }
+        const int end = bricks.CellIndex(row, colEnd);
+        for (int cell = bricks.NextActive(bricks.CellIndex(row, colBegin), end); cell != -1;
+             cell = bricks.NextActive(cell + 1, end)) {
+            cascade.Push(cell, CascadeAction::Break, element);
+            queued += 1;
+        }
+    }
+    return queued;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+#include "BrickField.h"
+#include "ReactionCascade.h"
+#include "ReactionQueue.h"
+#include "Rng.h"
+#include "SimulationConfig.h"
+
+// Grid-level reactions shared by the simulation and the benchmarks. Each works purely on
+// the brick field and returns how many bricks it changed where that is meaningful.
+
+// Freezes the 4-connected cluster of active bricks of targetColorIndex containing the start cell.
+int FreezeConnectedBricks(BrickField& bricks, int startRow, int startCol, int targetColorIndex);
+// Thaws the 4-connected frozen cluster containing the start cell, turning it blue.
+void ThawFrozenCluster(BrickField& bricks, int startRow, int startCol);
+// Queues Surge strikes on up to maxTargets live bricks along the diagonals from the start
+// cell, stepDelay apart per diagonal step, carrying the element that set them off.
+void ScheduleSurgeChain(ReactionQueue& events, const BrickField& bricks, int startRow, int startCol, int maxTargets,
+                        float stepDelay, int element);
+// Fills the field with a fresh randomized wave.
+void CreateBricks(BrickField& bricks, Rng& rng, const SimulationConfig& config);
+// Queues a break for every active brick in the blast footprint around the centre and
+// returns the count; the cascade destroys them and anything they set off. Only the
+// cells under the footprint are visited, so the cost follows the blast area.
+int QueueOverloadedAoE(ReactionCascade& cascade, const BrickField& bricks, int centerRow, int centerCol, int radius,
+                       AoEShape shape, int element);
@@ -0,0 +1,136 @@
+#include "Collision.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+float Dot(Vec2 a, Vec2 b) {
+    return a.x * b.x + a.y * b.y;
+}
+
+void ConsiderFace(float t, float along, float spanMin, float spanMax, Vec2 normal, SweepHit& best, bool& found) {
+    if (t < 0.0f || t > best.time) {
+        return;
+    }
+    if (along < spanMin || along > spanMax) {
+        return;
+    }
+    best.time = t;
+    best.normal = normal;
+    found = true;
+}
+
+void ConsiderCorner(Vec2 start, Vec2 delta, float radius, Vec2 corner, SweepHit& best, bool& found) {
+    Vec2 offset{start.x - corner.x, start.y - corner.y};
+    float a = Dot(delta, delta);
+    if (a <= 0.0f) {
+        return;
+    }
+    float b = Dot(offset, delta);
+    if (b >= 0.0f) {
+        return;  // moving away from the corner
+    }
+    float c = Dot(offset, offset) - radius * radius;
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) {
+        return;
+    }
+
+    float t = (-b - std::sqrt(discriminant)) / a;
+    if (t < 0.0f || t > best.time) {
+        return;
+    }
+
+    Vec2 contact{offset.x + delta.x * t, offset.y + delta.y * t};
+    float length = std::sqrt(Dot(contact, contact));
+    if (length <= 0.0f) {
+        return;
+    }
+    best.time = t;
+    best.normal = {contact.x / length, contact.y / length};
+    found = true;
+}
+}  // namespace
+
+bool CircleOverlapsRect(Vec2 center, float radius, Rect rect) {
+    float closestX = std::clamp(center.x, rect.x, rect.x + rect.width);
+    float closestY = std::clamp(center.y, rect.y, rect.y + rect.height);
+    float dx = center.x - closestX;
+    float dy = center.y - closestY;
+    return dx * dx + dy * dy < radius * radius;
+}
+
+bool SweepCircleRect(Vec2 start, Vec2 delta, float radius, Rect rect, SweepHit& hit) {
+    const float left = rect.x;
+    const float right = rect.x + rect.width;
+    const float top = rect.y;
+    const float bottom = rect.y + rect.height;
+
+    if (CircleOverlapsRect(start, radius, rect)) {
+        Vec2 normal{};
+        float closestX = std::clamp(start.x, left, right);
+        float closestY = std::clamp(start.y, top, bottom);
+        float dx = start.x - closestX;
+        float dy = start.y - closestY;
+        float distance = std::sqrt(dx * dx + dy * dy);
+        if (distance > 0.0f) {
+            normal = {dx / distance, dy / distance};
+        } else {
+            // Centre is inside the box: push out along the axis of least penetration.
+            float penLeft = start.x - left;
+            float penRight = right - start.x;
+            float penTop = start.y - top;
+            float penBottom = bottom - start.y;
+            float minPen = std::min({penLeft, penRight, penTop, penBottom});
+            if (minPen == penLeft) {
+                normal = {-1.0f, 0.0f};
+            } else if (minPen == penRight) {
+                normal = {1.0f, 0.0f};
+            } else if (minPen == penTop) {
+                normal = {0.0f, -1.0f};
+            } else {
+                normal = {0.0f, 1.0f};
+            }
+        }
+        if (Dot(delta, normal) >= 0.0f) {
+            return false;
+        }
+        hit.time = 0.0f;
+        hit.normal = normal;
+        return true;
+    }
+
+    SweepHit best{};
+    bool found = false;
+
+    if (delta.x > 0.0f) {
+        float t = (left - radius - start.x) / delta.x;
+        ConsiderFace(t, start.y + delta.y * t, top, bottom, {-1.0f, 0.0f}, best, found);
+    } else if (delta.x < 0.0f) {
+        float t = (right + radius - start.x) / delta.x;
+        ConsiderFace(t, start.y + delta.y * t, top, bottom, {1.0f, 0.0f}, best, found);
+    }
+    if (delta.y > 0.0f) {
+        float t = (top - radius - start.y) / delta.y;
+        ConsiderFace(t, start.x + delta.x * t, left, right, {0.0f, -1.0f}, best, found);
+    } else if (delta.y < 0.0f) {
+        float t = (bottom + radius - start.y) / delta.y;
+        ConsiderFace(t, start.x + delta.x * t, left, right, {0.0f, 1.0f}, best, found);
+    }
+
+    ConsiderCorner(start, delta, radius, {left, top}, best, found);
+    ConsiderCorner(start, delta, radius, {right, top}, best, found);
+    ConsiderCorner(start, delta, radius, {left, bottom}, best, found);
+    ConsiderCorner(start, delta, radius, {right, bottom}, best, found);
+
+    if (!found) {
+        return false;
+    }
+    hit = best;
+    return true;
+}
+
+Vec2 ReflectVelocity(Vec2 velocity, Vec2 normal) {
+    float d = Dot(velocity, normal);
+    return {velocity.x - 2.0f * d * normal.x, velocity.y - 2.0f * d * normal.y};
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "SimTypes.h"
+
+struct SweepHit {
+    float time{1.0f};  // fraction of the swept motion at first contact, in [0, 1]
+    Vec2 normal{};     // contact normal pointing from the obstacle towards the circle
+};
+
+// True when the circle overlaps the rectangle (touching does not count).
+bool CircleOverlapsRect(Vec2 center, float radius, Rect rect);
+
+// Sweeps a circle from start along delta against rect (a rounded-box Minkowski test:
+// four faces expanded by the radius plus four corner circles). Returns the earliest
+// contact in [0, 1]. A circle that already overlaps and is moving further in reports
+// a contact at time 0; one that is moving out is ignored.
+bool SweepCircleRect(Vec2 start, Vec2 delta, float radius, Rect rect, SweepHit& hit);
+
+// Reflects velocity about a unit normal.
+Vec2 ReflectVelocity(Vec2 velocity, Vec2 normal);
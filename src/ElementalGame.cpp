@@ -1,903 +1,356 @@
 #include "ElementalGame.h"
 
 #include "AudioManager.h"
+#include "BrickPalette.h"
 #include "GameConstants.h"
+#include "Replay.h"
 
 #include <algorithm>
 #include <cmath>
-#include <queue>
 
 namespace {
-const Color kBrickPalette[] = {
-    {255, 102, 0, 255},   // orange-red
-    {0, 112, 221, 255},   // blue
-    {0, 191, 165, 255},   // teal-green
-    {196, 120, 255, 255}, // light purple
-    {173, 216, 230, 255}, // light blue/white
-};
-constexpr int kBrickPaletteCount = sizeof(kBrickPalette) / sizeof(kBrickPalette[0]);
-
-constexpr int kColorIndexRed = 0;
-constexpr int kColorIndexBlue = 1;
-constexpr int kColorIndexGreen = 2;
-constexpr int kColorIndexPurple = 3;
-constexpr int kColorIndexLightBlue = 4;
-
-Brick* GetBrickAt(std::vector<Brick>& bricks, int row, int col) {
-    for (Brick& brick : bricks) {
-        if (brick.row == row && brick.col == col) {
-            return &brick;
-        }
-    }
-    return nullptr;
-}
-
-void DestroyBrick(Brick& brick) {
-    brick.active = false;
-    brick.hitPoints = 0;
-    brick.cracked = false;
-    brick.frozen = false;
-    brick.color = brick.baseColor;
-    brick.colorIndex = -1;
-}
-
-int FreezeConnectedBricks(std::vector<Brick>& bricks, int startRow, int startCol, int targetColorIndex) {
-    bool visited[BrickRows][BrickCols] = {};
-    std::queue<std::pair<int, int>> toVisit;
-    toVisit.emplace(startRow, startCol);
-
-    const std::pair<int, int> directions[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-    int frozenCount = 0;
-
-    while (!toVisit.empty()) {
-        auto [row, col] = toVisit.front();
-        toVisit.pop();
-
-        if (row < 0 || row >= BrickRows || col < 0 || col >= BrickCols) {
-            continue;
-        }
-        if (visited[row][col]) {
-            continue;
-        }
-        visited[row][col] = true;
-
-        Brick* brick = GetBrickAt(bricks, row, col);
-        if (brick == nullptr || !brick->active) {
-            continue;
-        }
-        if (brick->colorIndex != targetColorIndex) {
-            continue;
-        }
-
-        brick->originalColorIndex = brick->colorIndex;
-        brick->originalColor = brick->baseColor;
-        brick->frozen = true;
-        brick->baseColor = WHITE;
-        brick->color = WHITE;
-        frozenCount += 1;
-
-        for (const auto& dir : directions) {
-            toVisit.emplace(row + dir.first, col + dir.second);
-        }
-    }
-
-    return frozenCount;
-}
+// Largest render texture side the brick layer may use; bigger boards draw directly.
+constexpr int kMaxBrickLayerSize = 4096;
+
+InputFrame SampleInput() {
+    InputFrame input{};
+    input.moveLeft = IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A);
+    input.moveRight = IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D);
+    input.launch = IsKeyPressed(KEY_SPACE);
+    input.togglePause = IsKeyPressed(KEY_P);
+    input.forfeit = IsKeyPressed(KEY_Q);
+    input.restart = IsKeyPressed(KEY_ENTER);
 
-void ThawFrozenCluster(std::vector<Brick>& bricks, int startRow, int startCol) {
-    bool visited[BrickRows][BrickCols] = {};
-    std::queue<std::pair<int, int>> toVisit;
-    toVisit.emplace(startRow, startCol);
-
-    const std::pair<int, int> directions[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-
-    while (!toVisit.empty()) {
-        auto [row, col] = toVisit.front();
-        toVisit.pop();
-
-        if (row < 0 || row >= BrickRows || col < 0 || col >= BrickCols) {
-            continue;
-        }
-        if (visited[row][col]) {
-            continue;
-        }
-        visited[row][col] = true;
-
-        Brick* brick = GetBrickAt(bricks, row, col);
-        if (brick == nullptr || !brick->active || !brick->frozen) {
-            continue;
-        }
-
-        brick->frozen = false;
-        brick->colorIndex = kColorIndexBlue;
-        brick->baseColor = kBrickPalette[kColorIndexBlue];
-        brick->color = brick->baseColor;
-
-        for (const auto& dir : directions) {
-            toVisit.emplace(row + dir.first, col + dir.second);
+    const int keys[] = {KEY_ONE, KEY_TWO, KEY_THREE, KEY_FOUR, KEY_FIVE};
+    for (int i = 0; i < static_cast<int>(sizeof(keys) / sizeof(keys[0])); ++i) {
+        if (IsKeyPressed(keys[i])) {
+            input.elementSwap = i;
+            break;
         }
     }
+    return input;
 }
 
-void ScheduleSurgeChain(std::vector<ReactionEvent>& events, std::vector<Brick>& bricks, int startRow, int startCol) {
-    const std::pair<int, int> directions[] = {{1, 1}, {-1, -1}, {1, -1}, {-1, 1}};
-    int scheduled = 0;
-    for (const auto& dir : directions) {
-        int row = startRow + dir.first;
-        int col = startCol + dir.second;
-        int distance = 1;
-        while (row >= 0 && row < BrickRows && col >= 0 && col < BrickCols) {
-            Brick* target = GetBrickAt(bricks, row, col);
-            if (target != nullptr && target->active) {
-                events.push_back(ReactionEvent{row, col, SurgeChainStepDelay * static_cast<float>(distance), ReactionKind::SurgeChain});
-                scheduled += 1;
-                if (scheduled >= 4) {
-                    return;
-                }
-            }
-            row += dir.first;
-            col += dir.second;
-            distance += 1;
-        }
-    }
+Rectangle ToRectangle(const Rect& rect) {
+    return Rectangle{rect.x, rect.y, rect.width, rect.height};
 }
 
-std::vector<Brick> CreateBricks() {
-    std::vector<Brick> bricks;
-    bricks.reserve(BrickCols * BrickRows);
-
-    float totalSpacingX = (BrickCols + 1) * BrickSpacing;
-    float availableWidth = ScreenWidth - totalSpacingX;
-    float brickWidth = availableWidth / BrickCols;
-    for (int row = 0; row < BrickRows; ++row) {
-        int col = 0;
-        while (col < BrickCols) {
-            int remaining = BrickCols - col;
-            int chunkSize = GetRandomValue(3, 6);
-            if (chunkSize > remaining) {
-                chunkSize = remaining;
-            }
-
-            int colorIdx = -1;
-            Color chunkColor = {255, 221, 0, 255};  // default to yellow
-
-            int roll = GetRandomValue(1, 100);
-            if (roll <= 60) {
-                colorIdx = -1;
-                chunkColor = {255, 221, 0, 255};
-            } else if (roll <= 64) {
-                colorIdx = kColorIndexGreen;
-                chunkColor = kBrickPalette[colorIdx];
-            } else {
-                static const int kRemainingColors[] = {
-                    kColorIndexRed,
-                    kColorIndexBlue,
-                    kColorIndexPurple,
-                    kColorIndexLightBlue,
-                };
-                int remainder = roll - 64;  // 1-36
-                int index = (remainder - 1) / 9;
-                if (index < 0) {
-                    index = 0;
-                } else if (index > 3) {
-                    index = 3;
-                }
-                colorIdx = kRemainingColors[index];
-                chunkColor = kBrickPalette[colorIdx];
-            }
-
-            for (int i = 0; i < chunkSize; ++i) {
-                int currentCol = col + i;
-                float x = BrickSpacing + currentCol * (brickWidth + BrickSpacing);
-                float y = BrickTopOffset + row * (BrickHeight + BrickSpacing);
-
-                bool hasGap = GetRandomValue(0, 99) < 17;
-                if (hasGap) {
-                    continue;
-                }
-
-                bricks.push_back(Brick{
-                    {x, y, brickWidth, BrickHeight},
-                    true,
-                    chunkColor,
-                    chunkColor,
-                    row,
-                    currentCol,
-                    colorIdx,
-                    2,
-                    false,
-                    false,
-                });
-            }
+// What the bricks cost in one frame. The direct path issues raylib shape calls, which
+// raylib gathers into batches it flushes itself, so they are counted as shape calls
+// rather than draw calls.
+struct BrickDrawStats {
+    int drawCalls{0};
+    int shapeCalls{0};
+    long long vertices{0};
+};
 
-            col += chunkSize;
-        }
+void DrawBrick(const BrickField& bricks, int cell, BrickDrawStats* stats = nullptr) {
+    const Rectangle brickRect = ToRectangle(bricks.BrickRect(cell));
+    const BrickLook look = LookOfBrick(bricks, cell);
+    DrawRectangleRec(brickRect, look.fill);
+    if (look.outlined) {
+        DrawRectangleLinesEx(brickRect, kBrickOutlineWidth, look.outline);
     }
-
-    return bricks;
-}
-
-int ApplyOverloadedAoE(std::vector<Brick>& bricks, int centerRow, int centerCol) {
-    int removed = 0;
-    for (Brick& brick : bricks) {
-        if (!brick.active) {
-            continue;
-        }
-        int dRow = std::abs(brick.row - centerRow);
-        int dCol = std::abs(brick.col - centerCol);
-        if (dRow <= 1 && dCol <= 1) {
-            DestroyBrick(brick);
-            removed += 1;
-        }
+    if (stats != nullptr) {
+        // An outline is four more rectangles.
+        stats->shapeCalls += look.outlined ? 2 : 1;
+        stats->vertices += look.outlined ? 20 : 4;
     }
-    return removed;
 }
 
-int CountActiveBricks(const std::vector<Brick>& bricks) {
-    int count = 0;
-    for (const Brick& brick : bricks) {
-        if (brick.active) {
-            ++count;
-        }
+const char* BrickRendererName(BrickRenderer renderer) {
+    switch (renderer) {
+    case BrickRenderer::Cached:
+        return "cached";
+    case BrickRenderer::Mesh:
+        return "mesh";
+    case BrickRenderer::Direct:
+        break;
     }
-    return count;
+    return "direct";
 }
+
 }  // namespace
 
 ElementalGame::ElementalGame() = default;
 
+ElementalGame::ElementalGame(const SimulationConfig& config) : simulation_(config) {}
+
 void ElementalGame::Initialize(AudioManager* audioManager) {
     audio_ = audioManager;
     ResetRun();
+    hud_.Initialize(simulation_);
 }
 
-void ElementalGame::ResetRun() {
-    score_ = 0;
-    lives_ = 1;
-    paused_ = false;
-    gameOver_ = false;
-    gameOverSoundPlayed_ = false;
-    reactionEvents_.clear();
-    reactionMessage_ = {};
-
-    paddle_.speed = 640.0f;
-    paddle_.rect.width = 120.0f;
-    paddle_.rect.height = 20.0f;
-    ResetPaddlePosition();
-    paddle_.colorIndex = kColorIndexPurple;
-    paddle_.color = kBrickPalette[paddle_.colorIndex];
-
-    ball_ = {};
-    ball_.radius = 12.0f;
-    ball_.speed = 420.0f;
-    ball_.color = WHITE;
-    ball_.colorIndex = -1;
-    ResetBallOnPaddle();
-
-    bricks_ = CreateBricks();
-    colorSwitchCooldown_ = 0.0f;
-    ball_.superconductTimer = 0.0f;
-}
-
-void ElementalGame::ResetBallOnPaddle() {
-    ball_.inPlay = false;
-    ball_.position = {paddle_.rect.x + paddle_.rect.width * 0.5f, paddle_.rect.y - ball_.radius - 1.0f};
-    ball_.velocity = {0.0f, 0.0f};
-    ClearBallStatusEffects();
-    reactionMessage_.active = false;
-    reactionMessage_.text.clear();
-    reactionMessage_.timer = 0.0f;
+void ElementalGame::Shutdown() {
+    brickMesh_.Unload();
+    if (brickLayerReady_) {
+        UnloadRenderTexture(brickLayer_);
+        brickLayerReady_ = false;
+    }
 }
 
-void ElementalGame::ClearBallStatusEffects() {
-    if (ball_.frozen) {
-        float storedSpeed = std::sqrt(ball_.storedVelocity.x * ball_.storedVelocity.x + ball_.storedVelocity.y * ball_.storedVelocity.y);
-        if (storedSpeed <= 0.001f) {
-            ball_.velocity = {0.0f, -ball_.speed};
-        } else {
-            ball_.velocity = ball_.storedVelocity;
-        }
+void ElementalGame::ResetRun() {
+    simulation_.ResetRun();
+    simulation_.ConsumeEvents();
+    previousBallPosition_ = simulation_.GetBall().position;
+    previousPaddleX_ = simulation_.GetPaddle().rect.x;
+    pendingInput_ = {};
+    replayFinished_ = false;
+    if (recorder_) {
+        recorder_->Begin(simulation_.RunSeed(), simulationHz_, simulation_.Config());
     }
-
-    ball_.overloaded = false;
-    ball_.superconduct = false;
-    ball_.superconductTimer = 0.0f;
-    ball_.frozen = false;
-    ball_.freezeReady = false;
-    ball_.freezeTimer = 0.0f;
-    ball_.storedVelocity = {};
-    ball_.vaporizeReady = false;
 }
 
-void ElementalGame::ResetPaddlePosition() {
-    paddle_.rect.x = ScreenWidth / 2.0f - paddle_.rect.width * 0.5f;
-    paddle_.rect.y = ScreenHeight - 80.0f;
+void ElementalGame::SetSimulationRate(int hz) {
+    simulationHz_ = std::clamp(hz, 1, MaxSimulationHz);
+    stepDt_ = 1.0f / static_cast<float>(simulationHz_);
+    accumulator_ = 0.0f;
 }
 
-void ElementalGame::HandleMovement(float dt) {
-    float dx = 0.0f;
-    if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) {
-        dx -= paddle_.speed * dt;
+void ElementalGame::UpdateCameraZoom() {
+    float steps = GetMouseWheelMove();
+    if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) {
+        steps += 1.0f;
     }
-    if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) {
-        dx += paddle_.speed * dt;
+    if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) {
+        steps -= 1.0f;
     }
-
-    paddle_.rect.x += dx;
-    if (paddle_.rect.x < 0.0f) {
-        paddle_.rect.x = 0.0f;
-    }
-    if (paddle_.rect.x + paddle_.rect.width > ScreenWidth) {
-        paddle_.rect.x = ScreenWidth - paddle_.rect.width;
-    }
-}
-
-void ElementalGame::HandlePaddleColorInput() {
-    if (colorSwitchCooldown_ > 0.0f) {
+    if (steps == 0.0f) {
         return;
     }
 
-    const int keys[] = {KEY_ONE, KEY_TWO, KEY_THREE, KEY_FOUR, KEY_FIVE};
-    for (int i = 0; i < kBrickPaletteCount && i < static_cast<int>(sizeof(keys) / sizeof(keys[0])); ++i) {
-        if (IsKeyPressed(keys[i])) {
-            paddle_.colorIndex = i;
-            paddle_.color = kBrickPalette[i];
-            colorSwitchCooldown_ = 3.0f;
-            break;
-        }
-    }
+    // Zooming out stops once the whole world fits on screen.
+    const SimulationConfig& config = simulation_.Config();
+    const float fitZoom = std::min({1.0f, ScreenWidth / config.worldWidth, ScreenHeight / config.worldHeight});
+    cameraZoom_ = std::clamp(cameraZoom_ * std::pow(1.25f, steps), fitZoom, 4.0f);
 }
 
-void ElementalGame::SpawnWave() {
-    bricks_ = CreateBricks();
-    reactionEvents_.clear();
-    reactionMessage_ = {};
-    ResetBallOnPaddle();
-    gameOverSoundPlayed_ = false;
+Camera2D ElementalGame::WorldCamera(Vector2 focus) const {
+    const SimulationConfig& config = simulation_.Config();
+    Camera2D camera{};
+    camera.offset = Vector2{ScreenWidth * 0.5f, ScreenHeight * 0.5f};
+    camera.rotation = 0.0f;
+    camera.zoom = cameraZoom_;
+
+    // Follow the ball but keep the view inside the world; a world smaller than the view
+    // is centred, which leaves the stock board exactly where it always was.
+    auto follow = [](float focusAxis, float halfView, float extent) {
+        return extent <= 2.0f * halfView ? extent * 0.5f : std::clamp(focusAxis, halfView, extent - halfView);
+    };
+    camera.target = Vector2{
+        follow(focus.x, camera.offset.x / camera.zoom, config.worldWidth),
+        follow(focus.y, camera.offset.y / camera.zoom, config.worldHeight),
+    };
+    return camera;
 }
 
-void ElementalGame::LaunchBall() {
-    if (ball_.inPlay) {
+void ElementalGame::Update(float frameTime) {
+    UpdateCameraZoom();
+    if (replayFinished_) {
         return;
     }
 
-    float direction = GetRandomValue(0, 1) == 0 ? -1.0f : 1.0f;
-    Vector2 initialDir{direction * 0.6f, -1.0f};
-    float lengthSq = initialDir.x * initialDir.x + initialDir.y * initialDir.y;
-    if (lengthSq > 0.0f) {
-        float invLength = 1.0f / std::sqrt(lengthSq);
-        initialDir.x *= invLength;
-        initialDir.y *= invLength;
-    }
-
-    ball_.velocity = {initialDir.x * ball_.speed, initialDir.y * ball_.speed};
-    ball_.inPlay = true;
-}
-
-void ElementalGame::PlayBounce() {
-    if (audio_) {
-        audio_->PlayBounce();
-    }
-}
-
-void ElementalGame::PlayGameOver() {
-    if (audio_ && !gameOverSoundPlayed_) {
-        audio_->PlayGameOver();
-        gameOverSoundPlayed_ = true;
-    }
-}
-
-void ElementalGame::HandleBallWallCollisions() {
-    bool bounced = false;
-    if (ball_.position.x - ball_.radius <= 0.0f) {
-        ball_.position.x = ball_.radius;
-        ball_.velocity.x *= -1.0f;
-        bounced = true;
-    } else if (ball_.position.x + ball_.radius >= ScreenWidth) {
-        ball_.position.x = ScreenWidth - ball_.radius;
-        ball_.velocity.x *= -1.0f;
-        bounced = true;
-    }
-
-    if (ball_.position.y - ball_.radius <= 0.0f) {
-        ball_.position.y = ball_.radius;
-        ball_.velocity.y *= -1.0f;
-        bounced = true;
-    }
-
-    if (bounced) {
-        PlayBounce();
-    }
-}
-
-bool ElementalGame::HandleBallPaddleCollision() {
-    if (!ball_.inPlay) {
-        return false;
-    }
-
-    if (!CheckCollisionCircleRec(ball_.position, ball_.radius, paddle_.rect)) {
-        return false;
-    }
-
-    ball_.position.y = paddle_.rect.y - ball_.radius - 1.0f;
-    float paddleCenter = paddle_.rect.x + paddle_.rect.width * 0.5f;
-    float relative = (ball_.position.x - paddleCenter) / (paddle_.rect.width * 0.5f);
-    relative = std::clamp(relative, -1.0f, 1.0f);
-
-    Vector2 direction{relative, -1.0f};
-    float lengthSq = direction.x * direction.x + direction.y * direction.y;
-    if (lengthSq > 0.0f) {
-        float invLength = 1.0f / std::sqrt(lengthSq);
-        direction.x *= invLength;
-        direction.y *= invLength;
-    }
-    ball_.velocity = {direction.x * ball_.speed, direction.y * ball_.speed};
-
-    bool overloadedTrigger = (ball_.colorIndex == kColorIndexPurple && paddle_.colorIndex == kColorIndexRed) ||
-                             (ball_.colorIndex == kColorIndexRed && paddle_.colorIndex == kColorIndexPurple);
-    bool superconductTrigger = (ball_.colorIndex == kColorIndexPurple && paddle_.colorIndex == kColorIndexLightBlue) ||
-                               (ball_.colorIndex == kColorIndexLightBlue && paddle_.colorIndex == kColorIndexPurple);
-    bool freezeTrigger = (ball_.colorIndex == kColorIndexBlue && paddle_.colorIndex == kColorIndexLightBlue) ||
-                         (ball_.colorIndex == kColorIndexLightBlue && paddle_.colorIndex == kColorIndexBlue);
-
-    ClearBallStatusEffects();
-
-    if (paddle_.colorIndex >= 0 && paddle_.colorIndex < kBrickPaletteCount) {
-        ball_.colorIndex = paddle_.colorIndex;
-        ball_.color = kBrickPalette[paddle_.colorIndex];
-    } else {
-        ball_.colorIndex = -1;
-        ball_.color = WHITE;
-    }
-
-    ball_.overloaded = overloadedTrigger;
-    ball_.superconduct = superconductTrigger;
-    ball_.superconductTimer = superconductTrigger ? 1.0f : 0.0f;
-
-    if (freezeTrigger) {
-        ball_.freezeReady = true;
-        ball_.frozen = true;
-        ball_.freezeTimer = 2.0f;
-        ball_.storedVelocity = ball_.velocity;
-        ball_.velocity = {0.0f, 0.0f};
-    } else {
-        ball_.freezeReady = false;
-        ball_.frozen = false;
-        ball_.freezeTimer = 0.0f;
-        ball_.storedVelocity = {};
-    }
-
-    ball_.vaporizeReady = false;
-    PlayBounce();
-    return true;
-}
-
-int ElementalGame::HandleBallBrickCollision() {
-    int bricksBroken = 0;
-
-    for (Brick& brick : bricks_) {
-        if (!brick.active) {
-            continue;
-        }
-        if (!CheckCollisionCircleRec(ball_.position, ball_.radius, brick.rect)) {
-            continue;
-        }
-
-        int freezeColorIndex = brick.colorIndex;
-
-        if (ball_.freezeReady) {
-            int target = freezeColorIndex;
-            if (target != kColorIndexLightBlue) {
-                int frozenBricks = FreezeConnectedBricks(bricks_, brick.row, brick.col, target);
-                if (frozenBricks > 0) {
-                    reactionMessage_.text = "Freeze!";
-                    reactionMessage_.color = kBrickPalette[kColorIndexLightBlue];
-                    reactionMessage_.timer = 1.0f;
-                    reactionMessage_.active = true;
-                }
-            }
-            ball_.freezeReady = false;
-        }
-
-        bool brickBounced = false;
-
-        if (!ball_.superconduct) {
-            bool collidedFromLeft = ball_.position.x + ball_.radius <= brick.rect.x;
-            bool collidedFromRight = ball_.position.x - ball_.radius >= brick.rect.x + brick.rect.width;
-            bool collidedFromTop = ball_.position.y + ball_.radius <= brick.rect.y;
-            bool collidedFromBottom = ball_.position.y - ball_.radius >= brick.rect.y + brick.rect.height;
-
-            bool resolved = false;
-
-            if (collidedFromLeft || collidedFromRight) {
-                ball_.velocity.x *= -1.0f;
-                if (collidedFromLeft) {
-                    ball_.position.x = brick.rect.x - ball_.radius;
-                } else {
-                    ball_.position.x = brick.rect.x + brick.rect.width + ball_.radius;
-                }
-                resolved = true;
-                brickBounced = true;
-            }
-
-            if (!resolved && (collidedFromTop || collidedFromBottom)) {
-                ball_.velocity.y *= -1.0f;
-                if (collidedFromTop) {
-                    ball_.position.y = brick.rect.y - ball_.radius;
-                } else {
-                    ball_.position.y = brick.rect.y + brick.rect.height + ball_.radius;
-                }
-                resolved = true;
-                brickBounced = true;
-            }
-
-            if (!resolved) {
-                float brickCenterX = brick.rect.x + brick.rect.width * 0.5f;
-                float brickCenterY = brick.rect.y + brick.rect.height * 0.5f;
-                float diffX = ball_.position.x - brickCenterX;
-                float diffY = ball_.position.y - brickCenterY;
-
-                if (std::abs(diffX) > std::abs(diffY)) {
-                    ball_.velocity.x *= -1.0f;
-                    if (diffX > 0.0f) {
-                        ball_.position.x = brick.rect.x + brick.rect.width + ball_.radius;
-                    } else {
-                        ball_.position.x = brick.rect.x - ball_.radius;
-                    }
-                    brickBounced = true;
-                } else {
-                    ball_.velocity.y *= -1.0f;
-                    if (diffY > 0.0f) {
-                        ball_.position.y = brick.rect.y + brick.rect.height + ball_.radius;
-                    } else {
-                        ball_.position.y = brick.rect.y - ball_.radius;
-                    }
-                    brickBounced = true;
-                }
-            }
-        }
-
-        if (brickBounced) {
-            PlayBounce();
-        }
-
-        if (brick.frozen) {
-            if (ball_.colorIndex == kColorIndexRed) {
-                ball_.colorIndex = kColorIndexBlue;
-                ball_.color = kBrickPalette[kColorIndexBlue];
-                ball_.frozen = false;
-                ball_.freezeReady = false;
-                ball_.freezeTimer = 0.0f;
-                ball_.storedVelocity = {};
-                ball_.vaporizeReady = false;
-
-                ThawFrozenCluster(bricks_, brick.row, brick.col);
-            } else {
-                ball_.frozen = false;
-                ball_.freezeReady = false;
-                ball_.freezeTimer = 0.0f;
-                ball_.storedVelocity = {};
-            }
-            continue;
-        }
-
-        bool triggeredSwirl = (ball_.colorIndex == kColorIndexGreen) &&
-                              (brick.colorIndex != kColorIndexGreen) &&
-                              (brick.colorIndex != -1);
-
-        bool overloadTriggered = ball_.overloaded;
-        bool instantBreak = triggeredSwirl || overloadTriggered;
-        bool destroyedThisHit = false;
-        bool vaporizeTriggered = false;
-        bool infuseTriggered = false;
-        bool meltTriggered = false;
-        bool liquefyTriggered = false;
-        bool surgeTriggered = false;
-
-        if ((ball_.colorIndex == kColorIndexBlue && brick.colorIndex == kColorIndexRed) ||
-            (ball_.colorIndex == kColorIndexRed && brick.colorIndex == kColorIndexBlue)) {
-            instantBreak = true;
-            vaporizeTriggered = true;
-            reactionMessage_.text = "Vaporize!";
-            reactionMessage_.color = kBrickPalette[kColorIndexBlue];
-            reactionMessage_.timer = 1.0f;
-            reactionMessage_.active = true;
-        } else if (ball_.colorIndex == kColorIndexLightBlue && brick.colorIndex == kColorIndexRed) {
-            liquefyTriggered = true;
-            reactionMessage_.text = "Liquefy!";
-            reactionMessage_.color = kBrickPalette[kColorIndexBlue];
-            reactionMessage_.timer = 1.0f;
-            reactionMessage_.active = true;
-        } else if ((ball_.colorIndex == kColorIndexPurple && brick.colorIndex == kColorIndexBlue) ||
-                   (ball_.colorIndex == kColorIndexBlue && brick.colorIndex == kColorIndexPurple)) {
-            surgeTriggered = true;
-            instantBreak = true;
-            reactionMessage_.text = "Surge!";
-            reactionMessage_.color = kBrickPalette[kColorIndexPurple];
-            reactionMessage_.timer = 1.0f;
-            reactionMessage_.active = true;
-        } else if (ball_.colorIndex != kColorIndexGreen && brick.colorIndex == kColorIndexGreen) {
-            int infused = FreezeConnectedBricks(bricks_, brick.row, brick.col, kColorIndexGreen);
-            if (infused > 0) {
-                infuseTriggered = true;
-                reactionMessage_.text = "Infuse!";
-                reactionMessage_.color = kBrickPalette[kColorIndexGreen];
-                reactionMessage_.timer = 1.0f;
-                reactionMessage_.active = true;
-            }
-        }
-
-        if (instantBreak) {
-            DestroyBrick(brick);
-            destroyedThisHit = true;
-        } else if (liquefyTriggered) {
-            brick.baseColor = kBrickPalette[kColorIndexBlue];
-            brick.color = brick.baseColor;
-            brick.colorIndex = kColorIndexBlue;
-            brick.cracked = false;
-            brick.hitPoints = std::max(brick.hitPoints, 2);
-        } else if (infuseTriggered) {
-            brick.baseColor = ball_.color;
-            brick.color = ball_.color;
-            brick.colorIndex = ball_.colorIndex;
-        } else {
-            brick.hitPoints -= 1;
-            if (brick.hitPoints <= 0) {
-                DestroyBrick(brick);
-                destroyedThisHit = true;
-            } else {
-                brick.cracked = true;
-                brick.color = Color{
-                    static_cast<unsigned char>(std::clamp<int>(static_cast<int>(brick.baseColor.r * 0.65f), 0, 255)),
-                    static_cast<unsigned char>(std::clamp<int>(static_cast<int>(brick.baseColor.g * 0.65f), 0, 255)),
-                    static_cast<unsigned char>(std::clamp<int>(static_cast<int>(brick.baseColor.b * 0.65f), 0, 255)),
-                    brick.baseColor.a,
-                };
-            }
+    if (replay_ == nullptr) {
+        InputFrame sampled = SampleInput();
+        pendingInput_.moveLeft = sampled.moveLeft;
+        pendingInput_.moveRight = sampled.moveRight;
+        pendingInput_.launch = pendingInput_.launch || sampled.launch;
+        pendingInput_.togglePause = pendingInput_.togglePause || sampled.togglePause;
+        pendingInput_.forfeit = pendingInput_.forfeit || sampled.forfeit;
+        pendingInput_.restart = pendingInput_.restart || sampled.restart;
+        if (pendingInput_.elementSwap < 0) {
+            pendingInput_.elementSwap = sampled.elementSwap;
         }
+    }
 
-        if (triggeredSwirl) {
-            reactionEvents_.push_back(ReactionEvent{
-                brick.row,
-                brick.col,
-                OverloadAoEDelay,
-                ReactionKind::OverloadAoE,
-            });
-            reactionMessage_.text = "Swirl!";
-            reactionMessage_.color = kBrickPalette[kColorIndexGreen];
-            reactionMessage_.timer = 1.0f;
-            reactionMessage_.active = true;
+    accumulator_ += frameTime;
+    int steps = 0;
+    while (accumulator_ >= stepDt_ && steps < MaxSimulationStepsPerFrame) {
+        InputFrame input = pendingInput_;
+        if (replay_ && !replay_->Next(input)) {
+            replayFinished_ = true;
+            break;
         }
 
-        if (overloadTriggered) {
-            reactionEvents_.push_back(ReactionEvent{
-                brick.row,
-                brick.col,
-                OverloadAoEDelay,
-                ReactionKind::OverloadAoE,
-            });
-            reactionMessage_.text = "Overloaded!";
-            reactionMessage_.color = kBrickPalette[kColorIndexRed];
-            reactionMessage_.timer = 1.0f;
-            reactionMessage_.active = true;
-            ball_.overloaded = false;
+        previousBallPosition_ = simulation_.GetBall().position;
+        previousPaddleX_ = simulation_.GetPaddle().rect.x;
+        simulation_.Step(input, stepDt_);
+        if (recorder_) {
+            recorder_->Record(input);
         }
-
-        if (destroyedThisHit) {
-            bricksBroken += 1;
-            if (surgeTriggered) {
-                ScheduleSurgeChain(reactionEvents_, bricks_, brick.row, brick.col);
-            }
+        if (!simulation_.GetBall().inPlay) {
+            // The ball was reset onto the paddle; don't smear it across the screen.
+            previousBallPosition_ = simulation_.GetBall().position;
         }
 
-        break;
+        // Edges are delivered to exactly one step; held keys carry over.
+        pendingInput_ = InputFrame{pendingInput_.moveLeft, pendingInput_.moveRight};
+        accumulator_ -= stepDt_;
+        steps += 1;
     }
-
-    return bricksBroken;
-}
-
-int ElementalGame::ResolveReactionEvents(float dt) {
-    int removed = 0;
-    for (ReactionEvent& event : reactionEvents_) {
-        event.timer -= dt;
+    if (replayFinished_) {
+        accumulator_ = 0.0f;
+    } else if (accumulator_ >= stepDt_) {
+        // Too far behind (window drag, device init): drop the backlog instead of spiralling.
+        accumulator_ = std::fmod(accumulator_, stepDt_);
     }
+    renderAlpha_ = accumulator_ / stepDt_;
 
-    auto it = reactionEvents_.begin();
-    while (it != reactionEvents_.end()) {
-        if (it->timer <= 0.0f) {
-            if (it->kind == ReactionKind::OverloadAoE) {
-                removed += ApplyOverloadedAoE(bricks_, it->row, it->col);
-            } else if (it->kind == ReactionKind::SurgeChain) {
-                Brick* target = GetBrickAt(bricks_, it->row, it->col);
-                if (target && target->active) {
-                    DestroyBrick(*target);
-                    removed += 1;
-                }
-            }
-            it = reactionEvents_.erase(it);
-        } else {
-            ++it;
-        }
+    PlayEvents(simulation_.ConsumeEvents());
+    if (brickRenderer_ == BrickRenderer::Cached) {
+        UpdateBrickLayer();
+    } else if (brickRenderer_ == BrickRenderer::Mesh && brickMesh_.Update(simulation_.GetBricks())) {
+        simulation_.ClearBrickChanges();
     }
-    return removed;
+    hud_.Update(simulation_);
 }
 
-void ElementalGame::UpdateFreezeState(float dt) {
-    if (!ball_.inPlay || !ball_.frozen) {
+void ElementalGame::UpdateBrickLayer() {
+    const BrickField& bricks = simulation_.GetBricks();
+    const float layerWidth = std::ceil(simulation_.Config().worldWidth);
+    const float layerHeight = std::ceil(bricks.LayoutBottom());
+    if (!std::isfinite(layerHeight) || layerWidth > kMaxBrickLayerSize || layerHeight > kMaxBrickLayerSize) {
         return;
     }
-
-    ball_.freezeTimer -= dt;
-    ball_.position.x = paddle_.rect.x + paddle_.rect.width * 0.5f;
-    ball_.position.y = paddle_.rect.y - ball_.radius - 1.0f;
-    if (ball_.freezeTimer <= 0.0f) {
-        ball_.frozen = false;
-        float storedSpeed = std::sqrt(ball_.storedVelocity.x * ball_.storedVelocity.x + ball_.storedVelocity.y * ball_.storedVelocity.y);
-        if (storedSpeed <= 0.001f) {
-            ball_.velocity = {0.0f, -ball_.speed};
-        } else {
-            ball_.velocity = ball_.storedVelocity;
+    if (!brickLayerReady_) {
+        brickLayer_ = LoadRenderTexture(static_cast<int>(layerWidth), static_cast<int>(layerHeight));
+        if (brickLayer_.id == 0) {
+            return;
         }
-        ball_.storedVelocity = {};
+        brickLayerReady_ = true;
+        BeginTextureMode(brickLayer_);
+        ClearBackground(BLACK);
+        EndTextureMode();
     }
-}
 
-void ElementalGame::Update(float dt) {
-    if (!gameOver_ && IsKeyPressed(KEY_P)) {
-        paused_ = !paused_;
+    const bool redrawAll = bricks.AllDirty();
+    int cell = bricks.NextDirty(0);
+    if (!redrawAll && cell == -1) {
+        return;
     }
 
-    if (!paused_) {
-        UpdateFreezeState(dt);
-        if (ball_.superconduct && ball_.superconductTimer > 0.0f) {
-            ball_.superconductTimer -= dt;
-            if (ball_.superconductTimer <= 0.0f) {
-                ball_.superconduct = false;
-                ball_.superconductTimer = 0.0f;
-            }
-        }
-        if (ball_.superconduct && ball_.superconductTimer > 0.0f) {
-            ball_.superconductTimer -= dt;
-            if (ball_.superconductTimer <= 0.0f) {
-                ball_.superconduct = false;
-                ball_.superconductTimer = 0.0f;
-            }
+    BeginTextureMode(brickLayer_);
+    if (redrawAll) {
+        ClearBackground(BLACK);
+        for (int active = bricks.NextActive(0); active != -1; active = bricks.NextActive(active + 1)) {
+            DrawBrick(bricks, active);
         }
-        if (colorSwitchCooldown_ > 0.0f) {
-            colorSwitchCooldown_ = std::max(0.0f, colorSwitchCooldown_ - dt);
-        }
-        if (reactionMessage_.active) {
-            reactionMessage_.timer -= dt;
-            if (reactionMessage_.timer <= 0.0f) {
-                reactionMessage_.active = false;
-                reactionMessage_.text.clear();
+    } else {
+        // Wipe each changed cell's whole slot, then draw whatever brick is left in it.
+        const Vec2 origin = bricks.LayoutOrigin();
+        const Vec2 pitch = bricks.LayoutPitch();
+        for (; cell != -1; cell = bricks.NextDirty(cell + 1)) {
+            const float x = origin.x + static_cast<float>(bricks.ColOf(cell)) * pitch.x;
+            const float y = origin.y + static_cast<float>(bricks.RowOf(cell)) * pitch.y;
+            DrawRectangleRec(Rectangle{x, y, pitch.x, pitch.y}, BLACK);
+            if (bricks.IsActive(cell)) {
+                DrawBrick(bricks, cell);
             }
         }
     }
+    EndTextureMode();
+    simulation_.ClearBrickChanges();
+}
 
-    if (!paused_ && !gameOver_) {
-        HandleMovement(dt);
-        HandlePaddleColorInput();
-    }
-
-    if (!ball_.inPlay) {
-        ball_.position.x = paddle_.rect.x + paddle_.rect.width * 0.5f;
-        ball_.position.y = paddle_.rect.y - ball_.radius - 1.0f;
-    }
-
-    bool canAct = !paused_ && !gameOver_;
-
-    if (canAct && IsKeyPressed(KEY_SPACE)) {
-        LaunchBall();
-    }
-
-    if (canAct && IsKeyPressed(KEY_Q)) {
-        lives_ = 0;
-        gameOver_ = true;
-        ball_.inPlay = false;
-        PlayGameOver();
-    }
-
-    if (canAct && ball_.inPlay && !ball_.frozen) {
-        ball_.position.x += ball_.velocity.x * dt;
-        ball_.position.y += ball_.velocity.y * dt;
-
-        HandleBallWallCollisions();
-        bool hitPaddle = HandleBallPaddleCollision();
-        if (hitPaddle) {
-            if (ball_.overloaded) {
-                reactionMessage_.text = "Overloaded!";
-                reactionMessage_.color = kBrickPalette[kColorIndexRed];
-                reactionMessage_.timer = 1.0f;
-                reactionMessage_.active = true;
-            }
-            if (ball_.superconduct) {
-                reactionMessage_.text = "Superconduct!";
-                reactionMessage_.color = kBrickPalette[kColorIndexLightBlue];
-                reactionMessage_.timer = 1.0f;
-                reactionMessage_.active = true;
-            }
-            if (ball_.frozen) {
-                reactionMessage_.text = "Freeze!";
-                reactionMessage_.color = kBrickPalette[kColorIndexLightBlue];
-                reactionMessage_.timer = 1.0f;
-                reactionMessage_.active = true;
-            }
-        }
-        score_ += HandleBallBrickCollision();
-
-        if (CountActiveBricks(bricks_) == 0) {
-            SpawnWave();
-            ball_.speed *= 1.15f;
-        }
-
-        if (ball_.position.y - ball_.radius > ScreenHeight) {
-            lives_ -= 1;
-            if (lives_ <= 0) {
-                gameOver_ = true;
-                PlayGameOver();
-            }
-            ResetBallOnPaddle();
-        }
+void ElementalGame::PlayEvents(const SimulationEvents& events) {
+    if (!audio_) {
+        return;
     }
-
-    if (!paused_ && !gameOver_) {
-        int extraRemoved = ResolveReactionEvents(dt);
-        if (extraRemoved > 0) {
-            score_ += extraRemoved;
-        }
-        if (CountActiveBricks(bricks_) == 0) {
-            SpawnWave();
-            ball_.speed *= 1.15f;
-        }
+    if (events.bounces > 0) {
+        audio_->PlayBounce();
     }
-
-    if (gameOver_ && IsKeyPressed(KEY_ENTER)) {
-        ResetRun();
+    if (events.gameOver) {
+        audio_->PlayGameOver();
     }
 }
 
 void ElementalGame::Draw() const {
+    const Paddle& paddle = simulation_.GetPaddle();
+    const Ball& ball = simulation_.GetBall();
+    const BrickField& bricks = simulation_.GetBricks();
+
+    // Draw the paddle and ball between the last two simulation steps so motion stays smooth
+    // regardless of how the display rate lines up with the simulation rate.
+    Rectangle paddleRect = ToRectangle(paddle.rect);
+    paddleRect.x = previousPaddleX_ + (paddle.rect.x - previousPaddleX_) * renderAlpha_;
+    Vector2 ballPosition{
+        previousBallPosition_.x + (ball.position.x - previousBallPosition_.x) * renderAlpha_,
+        previousBallPosition_.y + (ball.position.y - previousBallPosition_.y) * renderAlpha_,
+    };
+
+    const Camera2D camera = WorldCamera(ballPosition);
+    const Vector2 viewMin = GetScreenToWorld2D(Vector2{0.0f, 0.0f}, camera);
+    const Vector2 viewMax = GetScreenToWorld2D(Vector2{static_cast<float>(ScreenWidth), static_cast<float>(ScreenHeight)}, camera);
+
     BeginDrawing();
     ClearBackground(BLACK);
+    BeginMode2D(camera);
+
+    BrickRenderer brickPath = brickRenderer_;
+    if ((brickPath == BrickRenderer::Cached && (!brickLayerReady_ || cameraZoom_ > 1.0f)) ||
+        (brickPath == BrickRenderer::Mesh && !brickMesh_.Ready())) {
+        brickPath = BrickRenderer::Direct;
+    }
+    const Rect view{viewMin.x, viewMin.y, viewMax.x - viewMin.x, viewMax.y - viewMin.y};
+    BrickDrawStats brickStats{};
+    if (brickPath == BrickRenderer::Cached) {
+        // The cached layer is one quad; render textures are stored upside down. Outlines
+        // blended into it left partial alpha behind, and over the black background a
+        // premultiplied blit reproduces exactly what drawing them directly gave.
+        const Texture2D& layer = brickLayer_.texture;
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        DrawTextureRec(layer, Rectangle{0.0f, 0.0f, static_cast<float>(layer.width), -static_cast<float>(layer.height)},
+                       Vector2{0.0f, 0.0f}, WHITE);
+        EndBlendMode();
+        brickStats.drawCalls = 1;
+        brickStats.vertices = 4;
+    } else if (brickPath == BrickRenderer::Mesh) {
+        brickStats.drawCalls = brickMesh_.Draw(view, brickStats.vertices);
+    } else {
+        // Zoomed in (the layer would look blocky) or too big to cache: draw the bricks under
+        // the view directly. Big boards are mostly off screen, so only those cells are visited.
+        const BrickField::CellRange visible = bricks.CellsOverlapping(view);
+        for (int row = visible.rowBegin; row < visible.rowEnd; ++row) {
+            const int rowEnd = bricks.CellIndex(row, visible.colEnd);
+            for (int cell = bricks.NextActive(bricks.CellIndex(row, visible.colBegin), rowEnd); cell != -1;
+                 cell = bricks.NextActive(cell + 1, rowEnd)) {
+                DrawBrick(bricks, cell, &brickStats);
+            }
+        }
+    }
 
-    DrawText("Elemental Breakout", ScreenWidth / 2 - MeasureText("Elemental Breakout", 32) / 2, 24, 32, WHITE);
+    DrawRectangleRounded(paddleRect, 0.9f, 16, ElementColor(paddle.colorIndex, WHITE));
+    DrawCircleV(ballPosition, ball.radius, ElementColor(ball.colorIndex, WHITE));
 
-    for (const Brick& brick : bricks_) {
-        if (!brick.active) {
+    // Extra balls are drawn at their latest step (no interpolation) as cheap polygons,
+    // since stress runs put thousands of them on screen.
+    const BallSwarm& extraBalls = simulation_.GetExtraBalls();
+    const Color extraBallColor = Fade(RAYWHITE, 0.85f);
+    const float extraRadius = extraBalls.Radius();
+    for (std::size_t i = 0; i < extraBalls.Size(); ++i) {
+        const float x = extraBalls.X()[i];
+        const float y = extraBalls.Y()[i];
+        if (x + extraRadius < viewMin.x || x - extraRadius > viewMax.x || y + extraRadius < viewMin.y ||
+            y - extraRadius > viewMax.y) {
             continue;
         }
-        Color drawColor = brick.cracked ? brick.color : brick.baseColor;
-        DrawRectangleRec(brick.rect, drawColor);
-        if (brick.cracked) {
-            DrawRectangleLinesEx(brick.rect, 2.0f, Fade(WHITE, 0.6f));
-        } else if (brick.frozen) {
-            DrawRectangleLinesEx(brick.rect, 2.0f, Fade(BLUE, 0.5f));
-        }
+        DrawPoly(Vector2{x, y}, 8, extraRadius, 0.0f, extraBallColor);
     }
 
-    DrawRectangleRounded(paddle_.rect, 0.9f, 16, paddle_.color);
-    DrawCircleV(ball_.position, ball_.radius, ball_.color);
-
-    DrawText(TextFormat("Score: %d", score_), 40, ScreenHeight - 60, 24, RAYWHITE);
-    DrawText(TextFormat("Lives: %d", lives_), ScreenWidth - 160, ScreenHeight - 60, 24, RAYWHITE);
-
-    const char* controlsText = "Left/Right or A/D to move, P to pause, Q to quit, 1-5 to change paddle color";
-    int controlsWidth = MeasureText(controlsText, 20);
-    DrawText(controlsText, ScreenWidth / 2 - controlsWidth / 2, ScreenHeight - 32, 20, GRAY);
+    EndMode2D();
 
-    if (reactionMessage_.active) {
-        int fontSize = 32;
-        int textWidth = MeasureText(reactionMessage_.text.c_str(), fontSize);
-        DrawText(reactionMessage_.text.c_str(), ScreenWidth / 2 - textWidth / 2, ScreenHeight - 200, fontSize, reactionMessage_.color);
-    }
-    if (paused_ && !gameOver_) {
-        DrawText("Paused - Press P to resume", ScreenWidth / 2 - 170, ScreenHeight / 2, 24, SKYBLUE);
-    }
-    if (gameOver_) {
-        DrawText("Game Over - Press ENTER to restart", ScreenWidth / 2 - 220, ScreenHeight / 2, 24, RED);
+    hud_.Draw(simulation_, replayFinished_);
+    if (showRenderStats_) {
+        const char* text =
+            brickPath == BrickRenderer::Direct
+                ? TextFormat("%d fps | bricks direct: %d shape calls (batched by raylib), %lld vertices", GetFPS(),
+                             brickStats.shapeCalls, brickStats.vertices)
+                : TextFormat("%d fps | bricks %s: %d draw calls, %lld vertices, %d uploaded", GetFPS(),
+                             BrickRendererName(brickPath), brickStats.drawCalls, brickStats.vertices,
+                             brickPath == BrickRenderer::Mesh ? brickMesh_.UploadedVertices() : 0);
+        DrawText(text, 8, 8, 10, GREEN);
     }
 
     EndDrawing();
 }
-
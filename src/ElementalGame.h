@@ -2,112 +2,84 @@
 
 #include <raylib.h>
 
-#include <string>
-#include <vector>
+#include <cstdint>
 
-#include "GameConstants.h"
+#include "BrickMesh.h"
+#include "Hud.h"
+#include "InputFrame.h"
+#include "Simulation.h"
 
 class AudioManager;
-
-struct Paddle {
-    Rectangle rect{};
-    float speed{640.0f};
-    int colorIndex{0};
-    Color color{WHITE};
-};
-
-struct Ball {
-    Vector2 position{};
-    Vector2 velocity{};
-    float radius{12.0f};
-    float speed{420.0f};
-    bool inPlay{false};
-    Color color{WHITE};
-    int colorIndex{-1};
-    bool overloaded{false};
-    bool superconduct{false};
-    float superconductTimer{0.0f};
-    bool frozen{false};
-    bool freezeReady{false};
-    float freezeTimer{0.0f};
-    Vector2 storedVelocity{};
-    bool vaporizeReady{false};
-};
-
-struct Brick {
-    Rectangle rect{};
-    bool active{true};
-    Color baseColor{WHITE};
-    Color color{WHITE};
-    int row{0};
-    int col{0};
-    int colorIndex{-1};
-    int hitPoints{2};
-    bool cracked{false};
-    bool frozen{false};
-    int originalColorIndex{-1};
-    Color originalColor{WHITE};
-};
-
-struct ReactionMessage {
-    std::string text{};
-    Color color{WHITE};
-    float timer{0.0f};
-    bool active{false};
-};
-
-enum class ReactionKind {
-    OverloadAoE,
-    SurgeChain,
-};
-
-struct ReactionEvent {
-    int row;
-    int col;
-    float timer;
-    ReactionKind kind;
+class ReplayPlayer;
+class ReplayRecorder;
+
+// How the brick field reaches the screen. Cached keeps it in a render texture redrawn
+// only where cells change, Mesh keeps it in one vertex buffer drawn in a single call
+// (the better fit when much of the board changes every frame), and Direct draws each
+// brick under the view with raylib shape calls. Boards too big for the chosen path, and
+// the cache when zoomed in, fall back to Direct.
+enum class BrickRenderer {
+    Cached,
+    Mesh,
+    Direct,
 };
 
+// Window-side shell around Simulation: samples the keyboard, drives the fixed-step
+// loop, forwards simulation events to audio and draws the current state.
 class ElementalGame {
 public:
     ElementalGame();
+    explicit ElementalGame(const SimulationConfig& config);
 
     void Initialize(AudioManager* audioManager);
+    // Releases GPU resources; call before closing the window.
+    void Shutdown();
     void ResetRun();
 
-    void Update(float dt);
+    // Runs as many fixed simulation steps as frameTime covers (capped per frame) and
+    // records how far the display is into the next step for interpolated drawing.
+    void SetSimulationRate(int hz);
+    void Update(float frameTime);
     void Draw() const;
 
-private:
-    void LaunchBall();
-    void SpawnWave();
-    void HandleBallWallCollisions();
-    bool HandleBallPaddleCollision();
-    int HandleBallBrickCollision();
-    int ResolveReactionEvents(float dt);
-    void UpdateFreezeState(float dt);
-    void ResetBallOnPaddle();
-    void ResetPaddlePosition();
-    void PlayBounce();
-    void PlayGameOver();
-    void HandleMovement(float dt);
-    void HandlePaddleColorInput();
-    void ClearBallStatusEffects();
+    void Seed(std::uint64_t seed) { simulation_.Seed(seed); }
+
+    // Every executed step's input is appended to recorder (restarted on each ResetRun).
+    void SetRecorder(ReplayRecorder* recorder) { recorder_ = recorder; }
+    // Drive the simulation from a recording instead of the keyboard.
+    void SetReplay(ReplayPlayer* replay) { replay_ = replay; }
+
+    void SetBrickRenderer(BrickRenderer renderer) { brickRenderer_ = renderer; }
+    // Overlays the frame rate and the draw calls and vertices the bricks took this frame.
+    void SetShowRenderStats(bool show) { showRenderStats_ = show; }
 
 private:
-    Paddle paddle_{};
-    Ball ball_{};
-    std::vector<Brick> bricks_;
-    std::vector<ReactionEvent> reactionEvents_;
-    ReactionMessage reactionMessage_{};
+    void PlayEvents(const SimulationEvents& events);
+    // Mouse wheel or +/- zoom; worlds larger than the window scroll with the ball.
+    void UpdateCameraZoom();
+    Camera2D WorldCamera(Vector2 focus) const;
+    // Redraws the changed cells into the cached brick layer (boards up to 4096 px only).
+    void UpdateBrickLayer();
 
+private:
+    Simulation simulation_;
     AudioManager* audio_{nullptr};
-
-    int score_{0};
-    int lives_{1};
-    bool paused_{false};
-    bool gameOver_{false};
-    bool gameOverSoundPlayed_{false};
-    float colorSwitchCooldown_{0.0f};
+    ReplayRecorder* recorder_{nullptr};
+    ReplayPlayer* replay_{nullptr};
+    bool replayFinished_{false};
+
+    int simulationHz_{DefaultSimulationHz};
+    float stepDt_{1.0f / DefaultSimulationHz};
+    float accumulator_{0.0f};
+    float renderAlpha_{0.0f};
+    InputFrame pendingInput_{};
+    Vec2 previousBallPosition_{};
+    float previousPaddleX_{0.0f};
+    float cameraZoom_{1.0f};
+    RenderTexture2D brickLayer_{};
+    bool brickLayerReady_{false};
+    BrickRenderer brickRenderer_{BrickRenderer::Cached};
+    BrickMesh brickMesh_;
+    Hud hud_;
+    bool showRenderStats_{false};
 };
-
@@ -0,0 +1,11 @@
+#pragma once
+
+// Element ids shared by the ball, the paddle and the bricks. -1 is the neutral
+// (yellow brick / white ball) element; the renderer owns the matching palette.
+constexpr int kColorIndexNone = -1;
+constexpr int kColorIndexRed = 0;
+constexpr int kColorIndexBlue = 1;
+constexpr int kColorIndexGreen = 2;
+constexpr int kColorIndexPurple = 3;
+constexpr int kColorIndexLightBlue = 4;
+constexpr int kElementCount = 5;
@@ -6,7 +6,11 @@ constexpr int BrickCols = 12;
 constexpr int BrickRows = 7;
 constexpr float BrickSpacing = 8.0f;
 constexpr float BrickHeight = 28.0f;
+constexpr float BrickWidth = (ScreenWidth - (BrickCols + 1) * BrickSpacing) / BrickCols;  // stock stretched width
 constexpr float BrickTopOffset = 100.0f;
 constexpr float OverloadAoEDelay = 0.18f;
 constexpr float SurgeChainStepDelay = 0.08f;
-
+constexpr int MaxBallContactsPerStep = 8;
+constexpr int DefaultSimulationHz = 240;
+constexpr int MaxSimulationHz = 10000;
+constexpr int MaxSimulationStepsPerFrame = 12;
@@ -0,0 +1,124 @@
+#include "Hud.h"
+
+#include <raylib.h>
+
+#include <cstdio>
+
+#include "BrickPalette.h"
+#include "GameConstants.h"
+
+namespace {
+const char kTitle[] = "Elemental Breakout";
+const char kControls[] = "Left/Right or A/D to move, P to pause, Q to quit, 1-5 to change paddle color";
+const char kReplayFinished[] = "Replay finished";
+
+constexpr int kTitleFontSize = 32;
+constexpr int kStatFontSize = 24;
+constexpr int kControlsFontSize = 20;
+constexpr int kMessageFontSize = 32;
+constexpr int kSeedFontSize = 20;
+
+constexpr int kCountFontSize = 20;
+constexpr int kCountSwatch = 14;
+constexpr int kCountGap = 18;
+}  // namespace
+
+bool Hud::Changed(Field& field, std::uint64_t value) {
+    if (field.valid && field.value == value) {
+        return false;
+    }
+    field.valid = true;
+    field.value = value;
+    return true;
+}
+
+void Hud::Initialize(const Simulation& simulation) {
+    titleWidth_ = MeasureText(kTitle, kTitleFontSize);
+    controlsWidth_ = MeasureText(kControls, kControlsFontSize);
+    replayFinishedWidth_ = MeasureText(kReplayFinished, kStatFontSize);
+    messageWidths_.resize(static_cast<std::size_t>(simulation.MessageCount()));
+    for (int id = 0; id < simulation.MessageCount(); ++id) {
+        messageWidths_[id] = MeasureText(simulation.MessageText(id), kMessageFontSize);
+    }
+    score_ = {};
+    lives_ = {};
+    seed_ = {};
+    brickCounts_ = {};
+    Update(simulation);
+}
+
+void Hud::Update(const Simulation& simulation) {
+    if (Changed(score_, static_cast<std::uint64_t>(simulation.Score()))) {
+        std::snprintf(score_.text, sizeof(score_.text), "Score: %d", simulation.Score());
+    }
+    if (Changed(lives_, static_cast<std::uint64_t>(simulation.Lives()))) {
+        std::snprintf(lives_.text, sizeof(lives_.text), "Lives: %d", simulation.Lives());
+    }
+    if (Changed(seed_, simulation.RunSeed())) {
+        std::snprintf(seed_.text, sizeof(seed_.text), "Seed: %llu", static_cast<unsigned long long>(simulation.RunSeed()));
+        seed_.width = MeasureText(seed_.text, kSeedFontSize);
+    }
+
+    const BrickField& bricks = simulation.GetBricks();
+    bool countsChanged = false;
+    for (int element = kColorIndexNone; element < kElementCount; ++element) {
+        Field& field = brickCounts_[element + 1];
+        const int count = bricks.CountElement(element);
+        if (Changed(field, static_cast<std::uint64_t>(count))) {
+            std::snprintf(field.text, sizeof(field.text), "%d", count);
+            field.width = MeasureText(field.text, kCountFontSize);
+            countsChanged = true;
+        }
+    }
+    if (countsChanged) {
+        brickCountsWidth_ = 0;
+        for (const Field& field : brickCounts_) {
+            if (field.value > 0) {
+                brickCountsWidth_ += kCountSwatch + 6 + field.width + kCountGap;
+            }
+        }
+    }
+}
+
+// Remaining bricks per element as colour swatches with counts, centred on y.
+void Hud::DrawBrickCounts(int y) const {
+    int x = ScreenWidth / 2 - (brickCountsWidth_ - kCountGap) / 2;
+    for (int element = kColorIndexNone; element < kElementCount; ++element) {
+        const Field& field = brickCounts_[element + 1];
+        if (field.value == 0) {
+            continue;
+        }
+        DrawRectangle(x, y + (kCountFontSize - kCountSwatch) / 2, kCountSwatch, kCountSwatch,
+                      ElementColor(element, kNeutralBrickColor));
+        x += kCountSwatch + 6;
+        DrawText(field.text, x, y, kCountFontSize, RAYWHITE);
+        x += field.width + kCountGap;
+    }
+}
+
+void Hud::Draw(const Simulation& simulation, bool replayFinished) const {
+    DrawText(kTitle, ScreenWidth / 2 - titleWidth_ / 2, 24, kTitleFontSize, WHITE);
+
+    DrawText(score_.text, 40, ScreenHeight - 60, kStatFontSize, RAYWHITE);
+    DrawText(lives_.text, ScreenWidth - 160, ScreenHeight - 60, kStatFontSize, RAYWHITE);
+    DrawBrickCounts(ScreenHeight - 58);
+
+    DrawText(kControls, ScreenWidth / 2 - controlsWidth_ / 2, ScreenHeight - 32, kControlsFontSize, GRAY);
+
+    const ReactionMessage& reactionMessage = simulation.GetReactionMessage();
+    if (reactionMessage.active && reactionMessage.text >= 0) {
+        const Color messageColor = ElementColor(reactionMessage.colorIndex, WHITE);
+        DrawText(simulation.MessageText(reactionMessage.text), ScreenWidth / 2 - messageWidths_[reactionMessage.text] / 2,
+                 ScreenHeight - 200, kMessageFontSize, messageColor);
+    }
+    if (simulation.IsPaused() && !simulation.IsGameOver()) {
+        DrawText("Paused - Press P to resume", ScreenWidth / 2 - 170, ScreenHeight / 2, kStatFontSize, SKYBLUE);
+    }
+    if (replayFinished) {
+        DrawText(kReplayFinished, ScreenWidth / 2 - replayFinishedWidth_ / 2, ScreenHeight / 2 - 40, kStatFontSize, SKYBLUE);
+    }
+    if (simulation.IsGameOver()) {
+        DrawText("Game Over - Press ENTER to restart", ScreenWidth / 2 - 220, ScreenHeight / 2, kStatFontSize, RED);
+        DrawText(seed_.text, ScreenWidth / 2 - seed_.width / 2, ScreenHeight / 2 + 36, kSeedFontSize, GRAY);
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Elements.h"
+#include "Simulation.h"
+
+// The text drawn over the playfield. Fixed strings and every banner message are measured
+// once, and numbers are re-formatted and re-measured only on the frames they change, so
+// drawing a frame does no text layout and no allocation.
+class Hud {
+public:
+    // Measures the fixed strings; needs the window's default font.
+    void Initialize(const Simulation& simulation);
+    // Re-formats whichever numbers changed since the last call.
+    void Update(const Simulation& simulation);
+    void Draw(const Simulation& simulation, bool replayFinished) const;
+
+private:
+    // A formatted number and its width in pixels.
+    struct Field {
+        bool valid{false};
+        std::uint64_t value{0};
+        char text[40]{};
+        int width{0};
+    };
+    // Records value; true when it differs from what the text shows.
+    static bool Changed(Field& field, std::uint64_t value);
+
+    void DrawBrickCounts(int y) const;
+
+    int titleWidth_{0};
+    int controlsWidth_{0};
+    int replayFinishedWidth_{0};
+    std::vector<int> messageWidths_;  // by message id
+    Field score_;
+    Field lives_;
+    Field seed_;
+    std::array<Field, kElementCount + 1> brickCounts_{};  // element + 1, neutral first
+    int brickCountsWidth_{0};
+};
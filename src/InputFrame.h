@@ -0,0 +1,13 @@
+#pragma once
+
+// One simulation step's worth of player input. Held keys are levels; the rest are
+// edges that fire once and are cleared after the step that consumes them.
+struct InputFrame {
+    bool moveLeft{false};
+    bool moveRight{false};
+    bool launch{false};
+    bool togglePause{false};
+    bool forfeit{false};
+    bool restart{false};
+    int elementSwap{-1};  // 0-4 when one of the 1-5 keys was pressed, otherwise -1
+};
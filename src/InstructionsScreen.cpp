@@ -2,11 +2,11 @@
 
 #include <raylib.h>
 
+#include <algorithm>
 #include <cmath>
-#include <sstream>
 
 namespace {
-const char* kHelpLines[] = {
+const char* kControlLines[] = {
     "Elemental Breakout - How to Play",
     "",
     "Controls",
@@ -18,15 +18,11 @@ const char* kHelpLines[] = {
     "  - P: Pause",
     "",
     "Elemental Reactions",
-    "  - Overloaded (Purple + Red paddle): Ball supercharges, next brick causes an AoE explosion.",
-    "  - Swirl (Green ball + non-green brick): Spreads the new element to nearby bricks.",
-    "  - Freeze (Blue + Light Blue paddle): Ball freezes on paddle, next brick freezes connected cluster.",
+};
+
+// Frozen-brick reactions live in the simulation rather than the rules file.
+const char* kClosingLines[] = {
     "  - Melt (Red ball + Frozen brick): Thaws the brick back to yellow.",
-    "  - Vaporize (Blue ball + Red brick): Instantly destroys the brick.",
-    "  - Liquefy (Light Blue ball + Red brick): Converts the brick to blue.",
-    "  - Superconduct (Purple + Light Blue paddle): Ball phases through bricks.",
-    "  - Surge (Purple ball + Blue brick, or Blue ball + Purple brick): Lightning arc clears diagonal lines.",
-    "  - Infuse (Any non-green ball + Green brick): Converts adjacent green bricks to the ball's element.",
     "  - Frozen clusters shattered by other colors chain-break neighboring frozen bricks.",
     "",
     "Progression",
@@ -35,50 +31,158 @@ const char* kHelpLines[] = {
     "",
     "Press Enter or Space to begin!"
 };
-constexpr int kHelpLineCount = sizeof(kHelpLines) / sizeof(kHelpLines[0]);
 
-std::vector<std::string> WrapLines(float maxWidth, int fontSize) {
-    std::vector<std::string> wrapped;
-    wrapped.reserve(kHelpLineCount * 2);
+const char kTitle[] = "Elemental Breakout";
+const char kHintScroll[] = "Mouse wheel / Arrow keys to scroll";
+const char kHintStart[] = "Press Enter or Space to start";
 
-    for (int i = 0; i < kHelpLineCount; ++i) {
-        const std::string line = kHelpLines[i];
-        if (line.empty()) {
-            wrapped.emplace_back("");
-            continue;
+constexpr int kFontSize = 22;
+constexpr int kLineSpacing = 28;
+// Taller text falls back to drawing the visible lines each frame.
+constexpr int kMaxTextureHeight = 4096;
+
+std::string HelpText(const ReactionRules& rules) {
+    std::string text;
+    for (const char* line : kControlLines) {
+        text.append(line).push_back('\n');
+    }
+    for (const ReactionText& help : rules.Texts()) {
+        if (!help.help.empty()) {
+            text.append("  - ").append(help.name).append(" (").append(help.when).append("): ").append(help.help).push_back('\n');
         }
+    }
+    for (const char* line : kClosingLines) {
+        text.append(line).push_back('\n');
+    }
+    return text;
+}
+}  // namespace
 
-        std::istringstream iss(line);
-        std::string word;
-        std::string current;
-        while (iss >> word) {
-            std::string candidate = current.empty() ? word : current + " " + word;
-            if (!current.empty() && MeasureText(candidate.c_str(), fontSize) > maxWidth) {
-                wrapped.push_back(current);
-                current = word;
-            } else {
-                current = candidate;
+void InstructionsScreen::Initialize(int screenWidth, int screenHeight, const ReactionRules& rules) {
+    scroll_ = 0.0f;
+    active_ = true;
+    text_ = HelpText(rules);
+    MeasureWords();
+    titleWidth_ = MeasureText(kTitle, 48);
+    hintScrollWidth_ = MeasureText(kHintScroll, 20);
+    hintStartWidth_ = MeasureText(kHintStart, 20);
+    Resize(screenWidth, screenHeight);
+}
+
+// Splits the text into lines and words and measures each word once. A run of words is as
+// wide as their widths plus, per gap of n spaces, n space advances and n + 1 glyph gaps,
+// which is exactly what MeasureText would return for the run.
+void InstructionsScreen::MeasureWords() {
+    const Font font = GetFontDefault();
+    // MeasureText's spacing for the default font.
+    glyphSpacing_ = static_cast<float>(std::max(kFontSize, 10) / 10);
+    spaceAdvance_ = MeasureTextEx(font, " ", static_cast<float>(kFontSize), glyphSpacing_).x;
+
+    words_.clear();
+    lines_.clear();
+    const int length = static_cast<int>(text_.size());
+    int pos = 0;
+    while (pos < length) {
+        Line line{static_cast<int>(words_.size()), 0};
+        int spaces = 0;
+        while (pos < length && text_[pos] != '\n') {
+            if (text_[pos] == ' ') {
+                spaces += 1;
+                pos += 1;
+                continue;
             }
+            const int begin = pos;
+            while (pos < length && text_[pos] != ' ' && text_[pos] != '\n') {
+                pos += 1;
+            }
+            const float width =
+                MeasureTextEx(font, TextSubtext(text_.c_str(), begin, pos - begin), static_cast<float>(kFontSize), glyphSpacing_).x;
+            words_.push_back(Word{begin, pos, line.wordCount == 0 ? 0 : spaces, width});
+            line.wordCount += 1;
+            spaces = 0;
         }
+        lines_.push_back(line);
+        pos += 1;  // the '\n'
+    }
+}
 
-        if (!current.empty()) {
-            wrapped.push_back(current);
+// Greedy wrap from the cached widths: a word that does not fit starts a new line, and a
+// word wider than the panel gets a line of its own. Leading spaces are dropped.
+void InstructionsScreen::Wrap() {
+    const float maxWidth = PanelRect().width - 80.0f;
+    spans_.clear();
+    for (const Line& line : lines_) {
+        if (line.wordCount == 0) {
+            spans_.push_back(Span{0, 0});
+            continue;
         }
+        const Word& first = words_[line.firstWord];
+        Span span{first.begin, first.end};
+        float width = first.width;
+        for (int i = line.firstWord + 1; i < line.firstWord + line.wordCount; ++i) {
+            const Word& word = words_[i];
+            const float gap = static_cast<float>(word.spacesBefore) * spaceAdvance_ +
+                              static_cast<float>(word.spacesBefore + 1) * glyphSpacing_;
+            const float extended = width + gap + word.width;
+            if (extended > maxWidth) {
+                spans_.push_back(span);
+                span = Span{word.begin, word.end};
+                width = word.width;
+            } else {
+                span.end = word.end;
+                width = extended;
+            }
+        }
+        spans_.push_back(span);
     }
-
-    return wrapped;
 }
-}  // namespace
 
-void InstructionsScreen::Initialize(int screenWidth, int screenHeight) {
+void InstructionsScreen::Resize(int screenWidth, int screenHeight) {
     screenWidth_ = screenWidth;
     screenHeight_ = screenHeight;
-    scroll_ = 0.0f;
-    active_ = true;
+    Wrap();
+    Rasterize();
+}
+
+void InstructionsScreen::Rasterize() {
+    const int width = std::max(static_cast<int>(PanelRect().width) - 80, 1);
+    const int height = static_cast<int>(spans_.size()) * kLineSpacing;
+    if (textureReady_ && (texture_.texture.width != width || texture_.texture.height != height)) {
+        Shutdown();
+    }
+    if (height == 0 || height > kMaxTextureHeight) {
+        return;
+    }
+    if (!textureReady_) {
+        texture_ = LoadRenderTexture(width, height);
+        if (texture_.id == 0) {
+            return;
+        }
+        textureReady_ = true;
+    }
 
-    const float panelWidth = static_cast<float>(screenWidth_) - 120.0f;
-    const float wrapWidth = panelWidth - 80.0f;
-    wrappedLines_ = WrapLines(wrapWidth, 22);
+    // Cleared to the panel's colour, so the blit needs no blending to look drawn in place.
+    BeginTextureMode(texture_);
+    ClearBackground(BLACK);
+    for (int i = 0; i < static_cast<int>(spans_.size()); ++i) {
+        DrawLine(i, 0, i * kLineSpacing);
+    }
+    EndTextureMode();
+}
+
+void InstructionsScreen::DrawLine(int i, int x, int y) const {
+    const Span& span = spans_[i];
+    if (span.end > span.begin) {
+        const Color lineColor = (i == 0) ? YELLOW : LIGHTGRAY;
+        DrawText(TextSubtext(text_.c_str(), span.begin, span.end - span.begin), x, y, kFontSize, lineColor);
+    }
+}
+
+void InstructionsScreen::Shutdown() {
+    if (textureReady_) {
+        UnloadRenderTexture(texture_);
+        textureReady_ = false;
+    }
 }
 
 void InstructionsScreen::Show() {
@@ -86,10 +190,21 @@ void InstructionsScreen::Show() {
     scroll_ = 0.0f;
 }
 
+Rectangle InstructionsScreen::PanelRect() const {
+    return Rectangle{60.0f, 80.0f, static_cast<float>(screenWidth_ - 120), static_cast<float>(screenHeight_ - 160)};
+}
+
+int InstructionsScreen::ViewHeight() const {
+    return std::max(static_cast<int>(PanelRect().height) - 80, 0);
+}
+
 void InstructionsScreen::Update(float dt) {
     if (!active_) {
         return;
     }
+    if (GetScreenWidth() != screenWidth_ || GetScreenHeight() != screenHeight_) {
+        Resize(GetScreenWidth(), GetScreenHeight());
+    }
 
     scroll_ += GetMouseWheelMove() * -48.0f;
     if (IsKeyDown(KEY_DOWN)) {
@@ -99,10 +214,8 @@ void InstructionsScreen::Update(float dt) {
         scroll_ -= 180.0f * dt;
     }
 
-    Rectangle panelRect{60.0f, 80.0f, static_cast<float>(screenWidth_ - 120), static_cast<float>(screenHeight_ - 160)};
-    const int lineSpacing = 28;
-    int availableHeight = static_cast<int>(panelRect.height) - 80;
-    int totalHeight = static_cast<int>(wrappedLines_.size()) * lineSpacing;
+    int availableHeight = ViewHeight();
+    int totalHeight = static_cast<int>(spans_.size()) * kLineSpacing;
 
     if (totalHeight < availableHeight) {
         scroll_ = 0.0f;
@@ -125,30 +238,38 @@ void InstructionsScreen::Draw() const {
 
     BeginDrawing();
     ClearBackground(BLACK);
-    DrawText("Elemental Breakout", screenWidth_ / 2 - MeasureText("Elemental Breakout", 48) / 2, 40, 48, WHITE);
+    DrawText(kTitle, screenWidth_ / 2 - titleWidth_ / 2, 40, 48, WHITE);
 
-    Rectangle panelRect{60.0f, 80.0f, static_cast<float>(screenWidth_ - 120), static_cast<float>(screenHeight_ - 160)};
+    const Rectangle panelRect = PanelRect();
     DrawRectangleRounded(panelRect, 0.1f, 8, Fade(BLACK, 0.85f));
     DrawRectangleRoundedLines(panelRect, 0.1f, 8, Fade(WHITE, 0.4f));
 
-    const int fontSize = 22;
-    const int lineSpacing = 28;
-    int baseY = static_cast<int>(panelRect.y) + 40;
-
-    for (size_t i = 0; i < wrappedLines_.size(); ++i) {
-        int drawY = baseY + static_cast<int>(i) * lineSpacing - static_cast<int>(scroll_);
-        if (drawY < panelRect.y + 30 || drawY > panelRect.y + panelRect.height - 50) {
-            continue;
+    // The text shows through a window of ViewHeight() pixels, scrolled by scroll_.
+    const int textX = static_cast<int>(panelRect.x) + 40;
+    const int textY = static_cast<int>(panelRect.y) + 40;
+    const int scroll = static_cast<int>(scroll_);
+    if (textureReady_) {
+        // Render textures are stored upside down, so rows [scroll, scroll + height) of the
+        // text sit at the mirrored end of the texture.
+        const Texture2D& texture = texture_.texture;
+        const int height = std::min(ViewHeight(), texture.height - scroll);
+        if (height > 0) {
+            DrawTextureRec(texture,
+                           Rectangle{0.0f, static_cast<float>(texture.height - scroll - height),
+                                     static_cast<float>(texture.width), -static_cast<float>(height)},
+                           Vector2{static_cast<float>(textX), static_cast<float>(textY)}, WHITE);
+        }
+    } else {
+        // Only the lines wholly inside the window.
+        const int first = (scroll + kLineSpacing - 1) / kLineSpacing;
+        const int last = std::min(static_cast<int>(spans_.size()), (scroll + ViewHeight() - kFontSize) / kLineSpacing + 1);
+        for (int i = first; i < last; ++i) {
+            DrawLine(i, textX, textY + i * kLineSpacing - scroll);
         }
-        Color lineColor = (i == 0) ? YELLOW : LIGHTGRAY;
-        DrawText(wrappedLines_[i].c_str(), static_cast<int>(panelRect.x) + 40, drawY, fontSize, lineColor);
     }
 
     int hintY = static_cast<int>(panelRect.y + panelRect.height) + 20;
-    const char* hintScroll = "Mouse wheel / Arrow keys to scroll";
-    const char* hintStart = "Press Enter or Space to start";
-    DrawText(hintScroll, screenWidth_ / 2 - MeasureText(hintScroll, 20) / 2, hintY, 20, GRAY);
-    DrawText(hintStart, screenWidth_ / 2 - MeasureText(hintStart, 20) / 2, hintY + 28, 20, GRAY);
+    DrawText(kHintScroll, screenWidth_ / 2 - hintScrollWidth_ / 2, hintY, 20, GRAY);
+    DrawText(kHintStart, screenWidth_ / 2 - hintStartWidth_ / 2, hintY + 28, 20, GRAY);
     EndDrawing();
 }
-
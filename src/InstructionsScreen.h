@@ -5,11 +5,21 @@
 #include <string>
 #include <vector>
 
+#include "ReactionRules.h"
+
+// The help screen shown at startup. Its text is measured word by word once, wrapped from
+// those widths (so a resize re-wraps without measuring or allocating) and rasterized
+// into one tall render texture; scrolling is a sub-rectangle blit of that texture.
 class InstructionsScreen {
 public:
     InstructionsScreen() = default;
 
-    void Initialize(int screenWidth, int screenHeight);
+    // Builds the help text, listing the reactions in rules. Needs the window.
+    void Initialize(int screenWidth, int screenHeight, const ReactionRules& rules);
+    // Re-wraps and re-rasterizes the text for a new window size.
+    void Resize(int screenWidth, int screenHeight);
+    // Releases the text texture; call before closing the window.
+    void Shutdown();
     void Show();
     bool IsActive() const { return active_; }
 
@@ -17,10 +27,44 @@ public:
     void Draw() const;
 
 private:
-    std::vector<std::string> wrappedLines_;
+    struct Word {
+        int begin;
+        int end;
+        int spacesBefore;  // within its line; 0 for a line's first word
+        float width;
+    };
+    struct Line {
+        int firstWord;
+        int wordCount;
+    };
+    // A wrapped line: the text_ characters [begin, end).
+    struct Span {
+        int begin;
+        int end;
+    };
+
+    void MeasureWords();
+    void Wrap();
+    void Rasterize();
+    Rectangle PanelRect() const;
+    int ViewHeight() const;
+    // Draws wrapped line i with its top at y.
+    void DrawLine(int i, int x, int y) const;
+
+    std::string text_;  // the help lines, each ended by '\n'
+    std::vector<Word> words_;
+    std::vector<Line> lines_;
+    std::vector<Span> spans_;
+    float spaceAdvance_{0.0f};
+    float glyphSpacing_{0.0f};
+
+    RenderTexture2D texture_{};
+    bool textureReady_{false};
+    int titleWidth_{0};
+    int hintScrollWidth_{0};
+    int hintStartWidth_{0};
     int screenWidth_{0};
     int screenHeight_{0};
     float scroll_{0.0f};
     bool active_{true};
 };
-
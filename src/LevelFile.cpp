@@ -0,0 +1,82 @@
+#include "LevelFile.h"
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include "TextParse.h"
+
+bool ParseLevel(const std::string& text, SimulationConfig& config, std::string& error) {
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        lineNumber += 1;
+        line = Trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+
+        std::size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            error = "line " + std::to_string(lineNumber) + ": expected key = value";
+            return false;
+        }
+        const std::string key = Trim(line.substr(0, equals));
+        const std::string valueText = Trim(line.substr(equals + 1));
+
+        struct Field {
+            const char* key;
+            float minValue;
+            float maxValue;
+            float* floatTarget;
+            int* intTarget;
+        };
+        const Field fields[] = {
+            {"rows", 1, kMaxGridSide, nullptr, &config.brickRows},
+            {"cols", 1, kMaxGridSide, nullptr, &config.brickCols},
+            {"brick_width", 0, kMaxBrickSize, &config.brickWidth, nullptr},
+            {"brick_height", 1, kMaxBrickSize, &config.brickHeight, nullptr},
+            {"spacing", 0, kMaxBrickSpacing, &config.brickSpacing, nullptr},
+            {"top_offset", 0, kMaxBrickTopOffset, &config.brickTopOffset, nullptr},
+            {"neutral", 0, 100, nullptr, &config.spawn.neutralPercent},
+            {"green", 0, 100, nullptr, &config.spawn.greenPercent},
+            {"gap", 0, 100, nullptr, &config.spawn.gapPercent},
+            {"split_chance", 0, 100, nullptr, &config.splitChancePercent},
+        };
+
+        const Field* field = nullptr;
+        for (const Field& candidate : fields) {
+            if (key == candidate.key) {
+                field = &candidate;
+                break;
+            }
+        }
+        if (field == nullptr) {
+            error = "line " + std::to_string(lineNumber) + ": unknown key '" + key + "'";
+            return false;
+        }
+
+        float value = 0.0f;
+        if (!ParseNumber(valueText, field->minValue, field->maxValue, value)) {
+            error = "line " + std::to_string(lineNumber) + ": bad value for '" + key + "'";
+            return false;
+        }
+        if (field->intTarget) {
+            *field->intTarget = static_cast<int>(value);
+        } else {
+            *field->floatTarget = value;
+        }
+    }
+    return true;
+}
+
+bool LoadLevelFile(const std::string& path, SimulationConfig& config, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open file";
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return ParseLevel(text, config, error);
+}
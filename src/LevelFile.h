@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+
+#include "SimulationConfig.h"
+
+// Level files override the playfield shape and wave odds of a SimulationConfig.
+//
+// One "key = value" per line; '#' starts a comment and unknown keys are errors.
+// Keys: rows, cols, brick_width, brick_height, spacing, top_offset (pixels; a
+// brick_width of 0 stretches the columns across the screen), neutral, green,
+// gap (spawn odds in percent) and split_chance (odds in percent of a broken brick
+// splitting the ball; default 0, splits off). Keys that are not given keep their
+// current value.
+//
+//     # 1024x1024 endurance board
+//     rows = 1024
+//     cols = 1024
+//     brick_width = 24
+//     brick_height = 12
+//     spacing = 2
+
+// On failure error names the offending line and config is left partly updated.
+bool ParseLevel(const std::string& text, SimulationConfig& config, std::string& error);
+bool LoadLevelFile(const std::string& path, SimulationConfig& config, std::string& error);
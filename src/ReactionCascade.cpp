@@ -0,0 +1,85 @@
+#include "ReactionCascade.h"
+
+#include <algorithm>
+
+namespace {
+constexpr int kActionCount = 2;
+}  // namespace
+
+void ReactionCascade::Reset(int cellCount) {
+    items_.clear();
+    head_ = 0;
+    stamps_.assign(static_cast<std::size_t>(cellCount) * kActionCount, 0);
+    generation_ = 1;
+}
+
+void ReactionCascade::Push(int cell, CascadeAction action, int element) {
+    std::uint32_t& stamp = stamps_[static_cast<std::size_t>(cell) * kActionCount + static_cast<int>(action)];
+    if (stamp == generation_) {
+        return;
+    }
+    stamp = generation_;
+    items_.push_back(CascadeItem{cell, action, static_cast<std::int8_t>(element)});
+}
+
+void ReactionCascade::Broken(const BrickField& bricks, int cell, int brickElement, bool wasFrozen, int element) {
+    if (wasFrozen) {
+        PushNeighbours(bricks, cell, CascadeAction::Break, element);
+    } else if (brickElement == kColorIndexGreen && element != kColorIndexGreen && element != kColorIndexNone) {
+        PushNeighbours(bricks, cell, CascadeAction::Infuse, element);
+    }
+}
+
+void ReactionCascade::PushNeighbours(const BrickField& bricks, int cell, CascadeAction action, int element) {
+    const int row = bricks.RowOf(cell);
+    const int col = bricks.ColOf(cell);
+    const int offsets[4][2] = {{-1, 0}, {0, -1}, {0, 1}, {1, 0}};
+    for (const auto& offset : offsets) {
+        const int nextRow = row + offset[0];
+        const int nextCol = col + offset[1];
+        if (!bricks.InBounds(nextRow, nextCol)) {
+            continue;
+        }
+        const int next = bricks.CellIndex(nextRow, nextCol);
+        if (!bricks.IsActive(next)) {
+            continue;
+        }
+        const bool matches = action == CascadeAction::Break ? bricks.IsFrozen(next)
+                                                            : bricks.Element(next) == kColorIndexGreen && !bricks.IsFrozen(next);
+        if (matches) {
+            Push(next, action, element);
+        }
+    }
+}
+
+int ReactionCascade::Run(BrickField& bricks, int budget) {
+    int removed = 0;
+    for (int processed = 0; processed < budget && head_ < items_.size(); ++processed) {
+        const CascadeItem item = items_[head_++];
+        if (!bricks.IsActive(item.cell)) {
+            continue;
+        }
+        if (item.action == CascadeAction::Break) {
+            const int brickElement = bricks.Element(item.cell);
+            const bool wasFrozen = bricks.IsFrozen(item.cell);
+            bricks.Destroy(item.cell);
+            removed += 1;
+            Broken(bricks, item.cell, brickElement, wasFrozen, item.element);
+        } else if (bricks.Element(item.cell) == kColorIndexGreen && !bricks.IsFrozen(item.cell)) {
+            bricks.SetElement(item.cell, item.element);
+            PushNeighbours(bricks, item.cell, CascadeAction::Infuse, item.element);
+        }
+    }
+
+    if (!items_.empty() && head_ == items_.size()) {
+        // The cascade is over: recycle the buffer and let every cell be queued again.
+        items_.clear();
+        head_ = 0;
+        generation_ += 1;
+        if (generation_ == 0) {
+            std::fill(stamps_.begin(), stamps_.end(), 0);
+            generation_ = 1;
+        }
+    }
+    return removed;
+}
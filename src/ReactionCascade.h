@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "BrickField.h"
+
+enum class CascadeAction : std::uint8_t {
+    Break,   // destroy the brick
+    Infuse,  // repaint a green brick to the item's element
+};
+
+struct CascadeItem {
+    int cell;
+    CascadeAction action;
+    std::int8_t element;  // element of whatever set the item off
+};
+
+// Brick breaks and recolours that can set off more of them, worked off first in, first
+// out so a cascade always unfolds in the same order.
+//
+// Breaking a frozen brick shatters its frozen 4-neighbours. Breaking a green brick with
+// another non-neutral element infuses its green 4-neighbours, which repaints the green
+// cluster to that element. Each cell is queued at most once per action per cascade (a
+// cascade ends when the queue drains), so cycles cannot form. Run works off at most `budget` items
+// per call and leaves the rest for the next call, so a board-wide cascade is spread
+// over several steps instead of stalling one.
+class ReactionCascade {
+public:
+    // Drops pending work; call whenever the field is rebuilt.
+    void Reset(int cellCount);
+    void Push(int cell, CascadeAction action, int element);
+    // Queues the follow-ups of a brick that was just broken outside the cascade.
+    void Broken(const BrickField& bricks, int cell, int brickElement, bool wasFrozen, int element);
+    // Processes up to budget items; returns how many bricks they destroyed.
+    int Run(BrickField& bricks, int budget);
+
+    bool Empty() const { return head_ == items_.size(); }
+    std::size_t Pending() const { return items_.size() - head_; }
+
+private:
+    void PushNeighbours(const BrickField& bricks, int cell, CascadeAction action, int element);
+
+    std::vector<CascadeItem> items_;
+    std::size_t head_{0};
+    std::vector<std::uint32_t> stamps_;  // per cell and action: the generation it was last queued in
+    std::uint32_t generation_{1};
+};
@@ -0,0 +1,37 @@
+#include "ReactionQueue.h"
+
+#include <algorithm>
+
+namespace {
+// std heap algorithms build a max-heap, so "less" means "fires later".
+struct FiresLater {
+    template <typename Entry>
+    bool operator()(const Entry& a, const Entry& b) const {
+        if (a.fireTime != b.fireTime) {
+            return a.fireTime > b.fireTime;
+        }
+        return a.sequence > b.sequence;
+    }
+};
+}  // namespace
+
+void ReactionQueue::Clear() {
+    heap_.clear();
+    now_ = 0.0;
+    nextSequence_ = 0;
+}
+
+void ReactionQueue::Schedule(const ReactionEvent& event, float delay) {
+    heap_.push_back(Entry{now_ + delay, nextSequence_++, event});
+    std::push_heap(heap_.begin(), heap_.end(), FiresLater{});
+}
+
+bool ReactionQueue::PopDue(ReactionEvent& event) {
+    if (heap_.empty() || heap_.front().fireTime > now_) {
+        return false;
+    }
+    std::pop_heap(heap_.begin(), heap_.end(), FiresLater{});
+    event = heap_.back().event;
+    heap_.pop_back();
+    return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+enum class ReactionKind {
+    OverloadAoE,
+    SurgeChain,
+};
+
+// Footprint of a blast: cells within radius by Chebyshev (square), Manhattan (diamond)
+// or Euclidean (circle) distance of the centre.
+enum class AoEShape : std::uint8_t {
+    Square,
+    Diamond,
+    Circle,
+};
+
+struct ReactionEvent {
+    int row;
+    int col;
+    ReactionKind kind;
+    int radius;      // blast radius in cells for OverloadAoE
+    AoEShape shape;  // and its footprint
+    int element;     // element of the ball that set it off
+};
+
+// Pending delayed reactions, ordered by absolute fire time on a binary min-heap.
+//
+// The queue keeps its own clock: Advance moves it forward and PopDue hands back every
+// event whose fire time has been reached, earliest first. Events due at the same time
+// fire in the order they were scheduled, so cascades stay deterministic. Nothing is
+// touched per pending event while time passes; scheduling and firing are O(log n).
+class ReactionQueue {
+public:
+    void Clear();
+    void Schedule(const ReactionEvent& event, float delay);
+    void Advance(float dt) { now_ += dt; }
+    bool PopDue(ReactionEvent& event);
+
+    bool Empty() const { return heap_.empty(); }
+    std::size_t Size() const { return heap_.size(); }
+
+private:
+    struct Entry {
+        double fireTime;
+        std::uint64_t sequence;
+        ReactionEvent event;
+    };
+
+    std::vector<Entry> heap_;
+    double now_{0.0};
+    std::uint64_t nextSequence_{0};
+};
@@ -0,0 +1,409 @@
+#include "ReactionRules.h"
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+#include "TextParse.h"
+
+namespace {
+// The stock rules. Brick rules are order-sensitive: the inert green pairs have to come
+// before Swirl, and Swirl before Infuse.
+const char kDefaultRules[] = R"(
+[Vaporize]
+on = brick
+ball = blue
+target = red
+both_ways = yes
+effects = destroy
+message = Vaporize!
+color = blue
+when = Blue ball + Red brick
+help = Instantly destroys the brick.
+
+[Liquefy]
+on = brick
+ball = light_blue
+target = red
+effects = recolor, repair
+recolor = blue
+message = Liquefy!
+color = blue
+when = Light Blue ball + Red brick
+help = Converts the brick to blue.
+
+[Surge]
+on = brick
+ball = purple
+target = blue
+both_ways = yes
+effects = destroy, chain
+chain_length = 4
+chain_delay = 0.08
+message = Surge!
+color = purple
+when = Purple ball + Blue brick, or Blue ball + Purple brick
+help = Lightning arc clears diagonal lines.
+
+[Green on green]
+on = brick
+ball = green
+target = green
+effects = none
+
+[Green on neutral]
+on = brick
+ball = green
+target = neutral
+effects = none
+
+[Swirl]
+on = brick
+ball = green
+target = any
+effects = destroy, aoe
+radius = 1
+delay = 0.18
+message = Swirl!
+color = green
+when = Green ball + non-green brick
+help = Spreads the new element to nearby bricks.
+
+[Infuse]
+on = brick
+ball = any
+target = green
+effects = freeze, recolor
+recolor = ball
+message = Infuse!
+color = green
+when = Any non-green ball + Green brick
+help = Converts adjacent green bricks to the ball's element.
+
+[Overloaded]
+on = paddle
+ball = purple
+target = red
+both_ways = yes
+effects = overload
+radius = 1
+delay = 0.18
+message = Overloaded!
+color = red
+when = Purple + Red paddle
+help = Ball supercharges, next brick causes an AoE explosion.
+
+[Superconduct]
+on = paddle
+ball = purple
+target = light_blue
+both_ways = yes
+effects = superconduct
+duration = 1
+message = Superconduct!
+color = light_blue
+when = Purple + Light Blue paddle
+help = Ball phases through bricks.
+
+[Freeze]
+on = paddle
+ball = blue
+target = light_blue
+both_ways = yes
+effects = freeze
+duration = 2
+message = Freeze!
+color = light_blue
+when = Blue + Light Blue paddle
+help = Ball freezes on paddle, next brick freezes connected cluster.
+)";
+
+constexpr int kAnyElement = -2;
+constexpr int kUnset = -3;
+
+constexpr std::uint16_t kBrickEffects =
+    kEffectDestroy | kEffectAoE | kEffectChain | kEffectRecolor | kEffectRepair | kEffectFreezeCluster;
+constexpr std::uint16_t kPaddleEffects = kEffectOverload | kEffectSuperconduct | kEffectFreezeBall;
+
+struct Rule {
+    int line{0};
+    int on{kUnset};  // 0 brick, 1 paddle
+    int ball{kUnset};
+    int target{kUnset};
+    bool bothWays{false};
+    bool effectsSet{false};
+    bool recolorSet{false};
+    ReactionEffect effect{};
+    ReactionText text{};
+};
+
+// Element names, plus the extra spellings a given key accepts (any, ball, white).
+bool ParseElement(const std::string& text, const char* extraName, int extraValue, int& element) {
+    static const struct {
+        const char* name;
+        int element;
+    } kNames[] = {
+        {"neutral", kColorIndexNone}, {"red", kColorIndexRed},       {"blue", kColorIndexBlue},
+        {"green", kColorIndexGreen},  {"purple", kColorIndexPurple}, {"light_blue", kColorIndexLightBlue},
+    };
+    for (const auto& entry : kNames) {
+        if (text == entry.name) {
+            element = entry.element;
+            return true;
+        }
+    }
+    if (extraName != nullptr && text == extraName) {
+        element = extraValue;
+        return true;
+    }
+    return false;
+}
+
+// Brick effect names; "freeze" means the paddle freeze on paddle rules (see FinishRule).
+bool ParseEffects(const std::string& text, std::uint16_t& flags) {
+    static const struct {
+        const char* name;
+        std::uint16_t flag;
+    } kEffects[] = {
+        {"none", 0},
+        {"destroy", kEffectDestroy},
+        {"aoe", kEffectAoE},
+        {"chain", kEffectChain},
+        {"recolor", kEffectRecolor},
+        {"repair", kEffectRepair},
+        {"freeze", kEffectFreezeCluster},
+        {"overload", kEffectOverload},
+        {"superconduct", kEffectSuperconduct},
+    };
+    flags = 0;
+    std::istringstream items(text);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        item = Trim(item);
+        bool known = false;
+        for (const auto& entry : kEffects) {
+            if (item == entry.name) {
+                flags |= entry.flag;
+                known = true;
+                break;
+            }
+        }
+        if (!known) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SetKey(Rule& rule, const std::string& key, const std::string& value) {
+    float number = 0.0f;
+    if (key == "on") {
+        rule.on = value == "brick" ? 0 : value == "paddle" ? 1 : kUnset;
+        return rule.on != kUnset;
+    }
+    if (key == "ball") {
+        return ParseElement(value, "any", kAnyElement, rule.ball);
+    }
+    if (key == "target") {
+        return ParseElement(value, "any", kAnyElement, rule.target);
+    }
+    if (key == "both_ways") {
+        rule.bothWays = value == "yes";
+        return value == "yes" || value == "no";
+    }
+    if (key == "effects") {
+        rule.effectsSet = true;
+        return ParseEffects(value, rule.effect.flags);
+    }
+    if (key == "recolor") {
+        int element = kColorIndexNone;
+        rule.recolorSet = ParseElement(value, "ball", kRecolorToBall, element);
+        rule.effect.recolor = static_cast<std::int8_t>(element);
+        return rule.recolorSet;
+    }
+    if (key == "radius") {
+        if (!ParseNumber(value, 0, 1024, number)) {
+            return false;
+        }
+        rule.effect.radius = static_cast<std::int16_t>(number);
+        return true;
+    }
+    if (key == "shape") {
+        static const struct {
+            const char* name;
+            AoEShape shape;
+        } kShapes[] = {{"square", AoEShape::Square}, {"diamond", AoEShape::Diamond}, {"circle", AoEShape::Circle}};
+        for (const auto& entry : kShapes) {
+            if (value == entry.name) {
+                rule.effect.shape = entry.shape;
+                return true;
+            }
+        }
+        return false;
+    }
+    if (key == "chain_length") {
+        if (!ParseNumber(value, 1, 1024, number)) {
+            return false;
+        }
+        rule.effect.chainLength = static_cast<std::int16_t>(number);
+        return true;
+    }
+    if (key == "delay") {
+        return ParseNumber(value, 0, 60, rule.effect.delay);
+    }
+    if (key == "chain_delay") {
+        return ParseNumber(value, 0, 60, rule.effect.chainDelay);
+    }
+    if (key == "duration") {
+        return ParseNumber(value, 0, 60, rule.effect.duration);
+    }
+    if (key == "message") {
+        rule.text.message = value;
+        return true;
+    }
+    if (key == "color") {
+        return ParseElement(value, "white", kColorIndexNone, rule.text.colorIndex);
+    }
+    if (key == "when") {
+        rule.text.when = value;
+        return true;
+    }
+    if (key == "help") {
+        rule.text.help = value;
+        return true;
+    }
+    return false;
+}
+
+// Checks a finished section; returns an error message or an empty string.
+std::string FinishRule(Rule& rule) {
+    if (rule.on == kUnset || rule.ball == kUnset || rule.target == kUnset || !rule.effectsSet) {
+        return "rule '" + rule.text.name + "' needs on, ball, target and effects";
+    }
+    std::uint16_t& flags = rule.effect.flags;
+    if (rule.on == 1 && (flags & kEffectFreezeCluster) != 0) {
+        flags = static_cast<std::uint16_t>((flags & ~kEffectFreezeCluster) | kEffectFreezeBall);
+    }
+    if ((flags & ~(rule.on == 0 ? kBrickEffects : kPaddleEffects)) != 0) {
+        return "rule '" + rule.text.name + "' has an effect that does not apply to its trigger";
+    }
+    if ((flags & kEffectRecolor) != 0 && !rule.recolorSet) {
+        return "rule '" + rule.text.name + "' recolors but sets no recolor element";
+    }
+    return {};
+}
+
+bool Matches(int ruleElement, int element) {
+    return ruleElement == kAnyElement || ruleElement == element;
+}
+
+bool RuleApplies(const Rule& rule, int ball, int other) {
+    return (Matches(rule.ball, ball) && Matches(rule.target, other)) ||
+           (rule.bothWays && Matches(rule.ball, other) && Matches(rule.target, ball));
+}
+}  // namespace
+
+const ReactionRules& ReactionRules::Defaults() {
+    static const ReactionRules defaults = [] {
+        ReactionRules rules;
+        std::string error;
+        ParseReactionRules(kDefaultRules, rules, error);
+        return rules;
+    }();
+    return defaults;
+}
+
+bool ParseReactionRules(const std::string& text, ReactionRules& rules, std::string& error) {
+    std::vector<Rule> parsed;
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        lineNumber += 1;
+        line = Trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+
+        if (line.front() == '[') {
+            if (line.back() != ']' || line.size() < 3) {
+                error = "line " + std::to_string(lineNumber) + ": expected [rule name]";
+                return false;
+            }
+            if (!parsed.empty()) {
+                error = FinishRule(parsed.back());
+                if (!error.empty()) {
+                    error = "line " + std::to_string(parsed.back().line) + ": " + error;
+                    return false;
+                }
+            }
+            parsed.emplace_back();
+            parsed.back().line = lineNumber;
+            parsed.back().text.name = Trim(line.substr(1, line.size() - 2));
+            continue;
+        }
+
+        std::size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            error = "line " + std::to_string(lineNumber) + ": expected key = value";
+            return false;
+        }
+        if (parsed.empty()) {
+            error = "line " + std::to_string(lineNumber) + ": key outside a [rule] section";
+            return false;
+        }
+        const std::string key = Trim(line.substr(0, equals));
+        if (!SetKey(parsed.back(), key, Trim(line.substr(equals + 1)))) {
+            error = "line " + std::to_string(lineNumber) + ": bad key or value '" + key + "'";
+            return false;
+        }
+    }
+    if (!parsed.empty()) {
+        error = FinishRule(parsed.back());
+        if (!error.empty()) {
+            error = "line " + std::to_string(parsed.back().line) + ": " + error;
+            return false;
+        }
+    }
+
+    ReactionRules result;
+    result.hash_ = 14695981039346656037ull;
+    for (unsigned char c : text) {
+        result.hash_ = (result.hash_ ^ c) * 1099511628211ull;
+    }
+    for (std::size_t i = 0; i < parsed.size(); ++i) {
+        if (parsed[i].effect.flags != 0) {
+            parsed[i].effect.text = static_cast<std::int16_t>(i);
+        }
+        result.texts_.push_back(parsed[i].text);
+    }
+    for (int ball = kColorIndexNone; ball < kElementCount; ++ball) {
+        for (int other = kColorIndexNone; other < kElementCount; ++other) {
+            bool brickFound = false;
+            bool paddleFound = false;
+            for (const Rule& rule : parsed) {
+                bool& found = rule.on == 0 ? brickFound : paddleFound;
+                if (found || !RuleApplies(rule, ball, other)) {
+                    continue;
+                }
+                found = true;
+                auto& table = rule.on == 0 ? result.brick_ : result.paddle_;
+                table[ReactionRules::Slot(ball, other)] = rule.effect;
+            }
+        }
+    }
+    rules = std::move(result);
+    error.clear();
+    return true;
+}
+
+bool LoadReactionRules(const std::string& path, ReactionRules& rules, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open file";
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return ParseReactionRules(text, rules, error);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Elements.h"
+#include "GameConstants.h"
+#include "ReactionQueue.h"
+
+// Element reactions as data. A rules file lists reactions as "[Name]" sections of
+// "key = value" lines ('#' starts a comment); parsing flattens them into two 6x6 tables
+// indexed by (ball element, other element) with the neutral element in slot 0, so each
+// contact costs one lookup and the rules can change without touching the simulation.
+//
+//     [Vaporize]
+//     on = brick              # brick: the ball hits a brick; paddle: it leaves the paddle
+//     ball = blue             # neutral, red, blue, green, purple, light_blue or any
+//     target = red            # the brick's or the paddle's element
+//     both_ways = yes         # also match with the ball and target elements swapped
+//     effects = destroy       # comma-separated; none makes the pair inert
+//     message = Vaporize!     # banner text, shown in color (an element name or white)
+//     color = blue
+//     when = Blue ball + Red brick         # the instructions line, left out when
+//     help = Instantly destroys the brick.  # help is empty
+//
+// Brick effects: destroy, aoe (radius, shape = square, diamond or circle, delay), chain
+// (chain_length, chain_delay), recolor (recolor = an element or ball), repair and freeze
+// (the brick's same-element cluster). Paddle effects: overload (the next brick hit blasts
+// with radius, shape and delay), superconduct and freeze (both last duration seconds).
+// The first rule that matches a pair wins.
+
+enum ReactionEffectFlags : std::uint16_t {
+    kEffectDestroy = 1u << 0,
+    kEffectAoE = 1u << 1,
+    kEffectChain = 1u << 2,
+    kEffectRecolor = 1u << 3,
+    kEffectRepair = 1u << 4,
+    kEffectFreezeCluster = 1u << 5,
+    kEffectOverload = 1u << 6,
+    kEffectSuperconduct = 1u << 7,
+    kEffectFreezeBall = 1u << 8,
+};
+
+constexpr int kElementSlots = kElementCount + 1;
+constexpr int kRecolorToBall = -2;
+
+// One table cell: everything a contact needs, stored inline.
+struct ReactionEffect {
+    std::uint16_t flags{0};
+    std::int16_t text{-1};  // index into ReactionRules::Texts(), -1 for no banner
+    std::int8_t recolor{kColorIndexNone};
+    AoEShape shape{AoEShape::Square};
+    std::int16_t radius{1};
+    std::int16_t chainLength{4};
+    float delay{OverloadAoEDelay};
+    float chainDelay{SurgeChainStepDelay};
+    float duration{0.0f};
+};
+
+// The parts of a rule only the banner and the instructions screen read.
+struct ReactionText {
+    std::string name;
+    std::string message;
+    int colorIndex{kColorIndexNone};
+    std::string when;
+    std::string help;
+};
+
+class ReactionRules {
+public:
+    // The stock rules, parsed once from the built-in rules text.
+    static const ReactionRules& Defaults();
+
+    const ReactionEffect& OnBrick(int ballElement, int brickElement) const {
+        return brick_[Slot(ballElement, brickElement)];
+    }
+    const ReactionEffect& OnPaddle(int ballElement, int paddleElement) const {
+        return paddle_[Slot(ballElement, paddleElement)];
+    }
+    const ReactionText& Text(int index) const { return texts_[index]; }
+    // One entry per rule, in file order.
+    const std::vector<ReactionText>& Texts() const { return texts_; }
+    // FNV-1a of the rules text, so a replay can tell whether it runs under the rules it was
+    // recorded with.
+    std::uint64_t Hash() const { return hash_; }
+
+private:
+    friend bool ParseReactionRules(const std::string& text, ReactionRules& rules, std::string& error);
+
+    static int Slot(int ballElement, int otherElement) { return (ballElement + 1) * kElementSlots + otherElement + 1; }
+
+    std::array<ReactionEffect, kElementSlots * kElementSlots> brick_{};
+    std::array<ReactionEffect, kElementSlots * kElementSlots> paddle_{};
+    std::vector<ReactionText> texts_;
+    std::uint64_t hash_{0};
+};
+
+// On failure error names the offending line and rules is left unchanged.
+bool ParseReactionRules(const std::string& text, ReactionRules& rules, std::string& error);
+bool LoadReactionRules(const std::string& path, ReactionRules& rules, std::string& error);
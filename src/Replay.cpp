@@ -0,0 +1,238 @@
+#include "Replay.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#include "ReactionRules.h"
+
+namespace {
+constexpr std::uint8_t kMagic[] = {'E', 'P', 'R', 'P'};
+constexpr std::uint8_t kVersion = 3;
+
+enum InputBits : std::uint32_t {
+    kBitMoveLeft = 1u << 0,
+    kBitMoveRight = 1u << 1,
+    kBitLaunch = 1u << 2,
+    kBitTogglePause = 1u << 3,
+    kBitForfeit = 1u << 4,
+    kBitRestart = 1u << 5,
+};
+constexpr int kElementSwapShift = 6;  // elementSwap + 1 in bits 6-8, 0 meaning none
+
+std::uint32_t PackInput(const InputFrame& input) {
+    std::uint32_t packed = 0;
+    packed |= input.moveLeft ? kBitMoveLeft : 0u;
+    packed |= input.moveRight ? kBitMoveRight : 0u;
+    packed |= input.launch ? kBitLaunch : 0u;
+    packed |= input.togglePause ? kBitTogglePause : 0u;
+    packed |= input.forfeit ? kBitForfeit : 0u;
+    packed |= input.restart ? kBitRestart : 0u;
+    packed |= static_cast<std::uint32_t>(input.elementSwap + 1) << kElementSwapShift;
+    return packed;
+}
+
+InputFrame UnpackInput(std::uint32_t packed) {
+    InputFrame input{};
+    input.moveLeft = (packed & kBitMoveLeft) != 0;
+    input.moveRight = (packed & kBitMoveRight) != 0;
+    input.launch = (packed & kBitLaunch) != 0;
+    input.togglePause = (packed & kBitTogglePause) != 0;
+    input.forfeit = (packed & kBitForfeit) != 0;
+    input.restart = (packed & kBitRestart) != 0;
+    input.elementSwap = static_cast<int>((packed >> kElementSwapShift) & 0x7u) - 1;
+    return input;
+}
+
+void WriteVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+bool ReadVarint(const std::vector<std::uint8_t>& in, std::size_t& cursor, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (cursor >= in.size()) {
+            return false;
+        }
+        std::uint8_t byte = in[cursor++];
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void WriteInt(std::vector<std::uint8_t>& out, int value) {
+    const auto wide = static_cast<std::int64_t>(value);
+    WriteVarint(out, (static_cast<std::uint64_t>(wide) << 1) ^ static_cast<std::uint64_t>(wide >> 63));
+}
+
+bool ReadInt(const std::vector<std::uint8_t>& in, std::size_t& cursor, int& value) {
+    std::uint64_t zigzag = 0;
+    if (!ReadVarint(in, cursor, zigzag)) {
+        return false;
+    }
+    value = static_cast<int>(static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1));
+    return true;
+}
+
+void WriteFloat(std::vector<std::uint8_t>& out, float value) {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    WriteVarint(out, bits);
+}
+
+bool ReadFloat(const std::vector<std::uint8_t>& in, std::size_t& cursor, float& value) {
+    std::uint64_t bits = 0;
+    if (!ReadVarint(in, cursor, bits) || bits > 0xFFFFFFFFu) {
+        return false;
+    }
+    const auto narrow = static_cast<std::uint32_t>(bits);
+    std::memcpy(&value, &narrow, sizeof(value));
+    return true;
+}
+
+// Visits the recorded settings in file order.
+template <typename Config, typename Int, typename Float>
+void ForEachConfigField(Config& config, Int&& onInt, Float&& onFloat) {
+    onInt(config.brickRows);
+    onInt(config.brickCols);
+    onFloat(config.brickWidth);
+    onFloat(config.brickHeight);
+    onFloat(config.brickSpacing);
+    onFloat(config.brickTopOffset);
+    onFloat(config.worldWidth);
+    onFloat(config.worldHeight);
+    onInt(config.spawn.neutralPercent);
+    onInt(config.spawn.greenPercent);
+    onInt(config.spawn.gapPercent);
+    onInt(config.spawn.minChunk);
+    onInt(config.spawn.maxChunk);
+    onInt(config.splitChancePercent);
+    onInt(config.maxExtraBalls);
+    onInt(config.stressBalls);
+    onInt(config.cascadeBudget);
+}
+}  // namespace
+
+void ReplayRecorder::Begin(std::uint64_t seed, int stepHz, const SimulationConfig& config) {
+    bytes_.assign(std::begin(kMagic), std::end(kMagic));
+    bytes_.push_back(kVersion);
+    WriteVarint(bytes_, seed);
+    WriteVarint(bytes_, static_cast<std::uint64_t>(stepHz));
+    ForEachConfigField(
+        config, [this](int value) { WriteInt(bytes_, value); }, [this](float value) { WriteFloat(bytes_, value); });
+    WriteVarint(bytes_, (config.rules != nullptr ? *config.rules : ReactionRules::Defaults()).Hash());
+    previousPacked_ = 0;
+    runPacked_ = 0;
+    runLength_ = 0;
+    stepCount_ = 0;
+    recording_ = true;
+}
+
+void ReplayRecorder::Record(const InputFrame& input) {
+    if (!recording_) {
+        return;
+    }
+
+    std::uint32_t packed = PackInput(input);
+    if (runLength_ > 0 && packed != runPacked_) {
+        WriteVarint(bytes_, runLength_);
+        WriteVarint(bytes_, runPacked_ ^ previousPacked_);
+        previousPacked_ = runPacked_;
+        runLength_ = 0;
+    }
+    runPacked_ = packed;
+    runLength_ += 1;
+    stepCount_ += 1;
+}
+
+bool ReplayRecorder::SaveToFile(const std::string& path) const {
+    if (!recording_) {
+        return false;
+    }
+
+    std::vector<std::uint8_t> bytes = bytes_;
+    if (runLength_ > 0) {
+        WriteVarint(bytes, runLength_);
+        WriteVarint(bytes, runPacked_ ^ previousPacked_);
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+bool ReplayPlayer::LoadFromFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return Load(std::move(bytes));
+}
+
+bool ReplayPlayer::Load(std::vector<std::uint8_t> bytes) {
+    bytes_ = std::move(bytes);
+    cursor_ = 0;
+    runPacked_ = 0;
+    runRemaining_ = 0;
+    stepsPlayed_ = 0;
+
+    if (bytes_.size() < sizeof(kMagic) + 1 || !std::equal(std::begin(kMagic), std::end(kMagic), bytes_.begin())) {
+        return false;
+    }
+    cursor_ = sizeof(kMagic);
+    if (bytes_[cursor_++] != kVersion) {
+        return false;
+    }
+
+    std::uint64_t stepHz = 0;
+    if (!ReadVarint(bytes_, cursor_, seed_) || !ReadVarint(bytes_, cursor_, stepHz) || stepHz == 0 ||
+        stepHz > MaxSimulationHz) {
+        return false;
+    }
+    stepHz_ = static_cast<int>(stepHz);
+
+    config_ = SimulationConfig{};
+    bool ok = true;
+    ForEachConfigField(
+        config_, [&](int& value) { ok = ok && ReadInt(bytes_, cursor_, value); },
+        [&](float& value) { ok = ok && ReadFloat(bytes_, cursor_, value); });
+    // The settings feed straight into the simulation, so a damaged or hand-made file must
+    // not get past the bounds the flags and level files are held to.
+    return ok && WithinLimits(config_) && ReadVarint(bytes_, cursor_, rulesHash_);
+}
+
+void ReplayPlayer::ApplyConfig(SimulationConfig& config) const {
+    const ReactionRules* rules = config.rules;
+    config = config_;
+    config.rules = rules;
+}
+
+bool ReplayPlayer::Next(InputFrame& input) {
+    if (runRemaining_ == 0) {
+        std::uint64_t length = 0;
+        std::uint64_t delta = 0;
+        if (!ReadVarint(bytes_, cursor_, length) || !ReadVarint(bytes_, cursor_, delta) || length == 0) {
+            return false;
+        }
+        runPacked_ ^= static_cast<std::uint32_t>(delta);
+        runRemaining_ = length;
+    }
+
+    input = UnpackInput(runPacked_);
+    runRemaining_ -= 1;
+    stepsPlayed_ += 1;
+    return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "InputFrame.h"
+#include "SimulationConfig.h"
+
+// Replay files hold the run seed, step rate and the settings that shape the run (grid,
+// world size, wave odds, extra balls, cascade budget) followed by every step's input,
+// so a recording plays back the same whatever flags it is replayed with. The reaction
+// rules are too big to embed; their hash is kept so playback can refuse other rules.
+//
+// Layout: "EPRP", a version byte, varint seed, varint step rate, the settings (ints
+// zigzag varints, floats their bit patterns as varints), varint rules hash, then records of (varint repeat
+// count, varint packed input XOR the previous record's input). Held keys collapse into
+// one record per change, so a minute of play is a few KB at most.
+
+class ReplayRecorder {
+public:
+    void Begin(std::uint64_t seed, int stepHz, const SimulationConfig& config);
+    void Record(const InputFrame& input);
+    bool SaveToFile(const std::string& path) const;
+
+    bool IsRecording() const { return recording_; }
+    std::uint64_t StepCount() const { return stepCount_; }
+
+private:
+    std::vector<std::uint8_t> bytes_;
+    std::uint32_t previousPacked_{0};
+    std::uint32_t runPacked_{0};
+    std::uint64_t runLength_{0};
+    std::uint64_t stepCount_{0};
+    bool recording_{false};
+};
+
+class ReplayPlayer {
+public:
+    // False for a malformed file, and for recorded settings or a step rate out of bounds
+    // (WithinLimits, MaxSimulationHz).
+    bool LoadFromFile(const std::string& path);
+    bool Load(std::vector<std::uint8_t> bytes);
+
+    std::uint64_t Seed() const { return seed_; }
+    int StepHz() const { return stepHz_; }
+    // Overwrites the recorded settings in config; everything else (the rules) is kept.
+    void ApplyConfig(SimulationConfig& config) const;
+    // ReactionRules::Hash() of the rules the recording was made with.
+    std::uint64_t RulesHash() const { return rulesHash_; }
+    std::uint64_t StepsPlayed() const { return stepsPlayed_; }
+
+    // Fills input with the next recorded step; false once the recording is exhausted.
+    bool Next(InputFrame& input);
+
+private:
+    std::vector<std::uint8_t> bytes_;
+    std::size_t cursor_{0};
+    std::uint64_t seed_{0};
+    int stepHz_{0};
+    SimulationConfig config_{};
+    std::uint64_t rulesHash_{0};
+    std::uint32_t runPacked_{0};
+    std::uint64_t runRemaining_{0};
+    std::uint64_t stepsPlayed_{0};
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+// Small, fast and fully deterministic PRNG (xoshiro256** seeded through splitmix64).
+// Unlike std::uniform_int_distribution its output is identical on every standard
+// library, which is what makes a seed reproduce the same run everywhere.
+class Rng {
+public:
+    Rng() { Seed(0); }
+    explicit Rng(std::uint64_t seed) { Seed(seed); }
+
+    void Seed(std::uint64_t seed) {
+        for (std::uint64_t& word : state_) {
+            seed += 0x9E3779B97F4A7C15ull;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    std::uint64_t Next() {
+        const std::uint64_t result = Rotl(state_[1] * 5, 7) * 9;
+        const std::uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = Rotl(state_[3], 45);
+        return result;
+    }
+
+    // Uniform integer in [min, max], inclusive on both ends like raylib's GetRandomValue.
+    int Range(int min, int max) {
+        const std::uint64_t span = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min) + 1;
+        const std::uint64_t high = Next() >> 32;
+        return min + static_cast<int>((high * span) >> 32);
+    }
+
+private:
+    static std::uint64_t Rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    std::uint64_t state_[4]{};
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+// Plain geometry types for the simulation core. Field names match raylib's Vector2
+// and Rectangle so the render shell can convert them member for member.
+struct Vec2 {
+    float x{0.0f};
+    float y{0.0f};
+};
+
+struct Rect {
+    float x{0.0f};
+    float y{0.0f};
+    float width{0.0f};
+    float height{0.0f};
+};
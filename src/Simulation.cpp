@@ -0,0 +1,703 @@
+#include "Simulation.h"
+
+#include "BrickReactions.h"
+#include "Collision.h"
+#include "GameConstants.h"
+#include "ReactionRules.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+Simulation::Simulation() {
+    InternMessages();
+}
+
+Simulation::Simulation(const SimulationConfig& config) : config_(config) {
+    if (config.rules != nullptr) {
+        rules_ = config.rules;
+    }
+    InternMessages();
+}
+
+void Simulation::InternMessages() {
+    messageTexts_.clear();
+    for (const ReactionText& text : rules_->Texts()) {
+        messageTexts_.push_back(text.message.c_str());
+    }
+    freezeMessage_ = static_cast<int>(messageTexts_.size());
+    messageTexts_.push_back("Freeze!");
+    splitMessage_ = static_cast<int>(messageTexts_.size());
+    messageTexts_.push_back("Split!");
+}
+
+void Simulation::Seed(std::uint64_t seed) {
+    seed_ = seed;
+}
+
+void Simulation::ResetRun() {
+    rng_.Seed(seed_);
+    score_ = 0;
+    lives_ = 1;
+    paused_ = false;
+    gameOver_ = false;
+    gameOverSoundPlayed_ = false;
+    reactionEvents_.Clear();
+    reactionMessage_ = {};
+    stats_ = {};
+
+    paddle_.speed = 640.0f;
+    paddle_.rect.width = 120.0f;
+    paddle_.rect.height = 20.0f;
+    ResetPaddlePosition();
+    paddle_.colorIndex = kColorIndexPurple;
+
+    ball_ = {};
+    ball_.radius = 12.0f;
+    ball_.speed = 420.0f;
+    ball_.colorIndex = -1;
+    ResetBallOnPaddle();
+
+    CreateBricks(bricks_, rng_, config_);
+    cascade_.Reset(bricks_.CellCount());
+    extraBalls_.Clear();
+    extraBalls_.SetRadius(ball_.radius * 0.75f);
+    SpawnStressBalls();
+    colorSwitchCooldown_ = 0.0f;
+    ball_.superconductTimer = 0.0f;
+}
+
+void Simulation::ResetBallOnPaddle() {
+    ball_.inPlay = false;
+    ball_.position = {paddle_.rect.x + paddle_.rect.width * 0.5f, paddle_.rect.y - ball_.radius - 1.0f};
+    ball_.velocity = {0.0f, 0.0f};
+    ClearBallStatusEffects();
+    reactionMessage_.active = false;
+    reactionMessage_.text = -1;
+    reactionMessage_.timer = 0.0f;
+}
+
+void Simulation::ClearBallStatusEffects() {
+    if (ball_.frozen) {
+        float storedSpeed = std::sqrt(ball_.storedVelocity.x * ball_.storedVelocity.x + ball_.storedVelocity.y * ball_.storedVelocity.y);
+        if (storedSpeed <= 0.001f) {
+            ball_.velocity = {0.0f, -ball_.speed};
+        } else {
+            ball_.velocity = ball_.storedVelocity;
+        }
+    }
+
+    ball_.overloaded = false;
+    ball_.superconduct = false;
+    ball_.superconductTimer = 0.0f;
+    ball_.frozen = false;
+    ball_.freezeReady = false;
+    ball_.freezeTimer = 0.0f;
+    ball_.storedVelocity = {};
+    ball_.vaporizeReady = false;
+}
+
+void Simulation::ResetPaddlePosition() {
+    paddle_.rect.x = config_.worldWidth / 2.0f - paddle_.rect.width * 0.5f;
+    paddle_.rect.y = config_.worldHeight - 80.0f;
+}
+
+void Simulation::HandleMovement(const InputFrame& input, float dt) {
+    float dx = 0.0f;
+    if (input.moveLeft) {
+        dx -= paddle_.speed * dt;
+    }
+    if (input.moveRight) {
+        dx += paddle_.speed * dt;
+    }
+
+    paddle_.rect.x += dx;
+    if (paddle_.rect.x < 0.0f) {
+        paddle_.rect.x = 0.0f;
+    }
+    if (paddle_.rect.x + paddle_.rect.width > config_.worldWidth) {
+        paddle_.rect.x = config_.worldWidth - paddle_.rect.width;
+    }
+}
+
+void Simulation::HandlePaddleColorInput(const InputFrame& input) {
+    if (colorSwitchCooldown_ > 0.0f) {
+        return;
+    }
+
+    if (input.elementSwap >= 0 && input.elementSwap < kElementCount) {
+        paddle_.colorIndex = input.elementSwap;
+        colorSwitchCooldown_ = 3.0f;
+    }
+}
+
+void Simulation::SpawnWave() {
+    stats_.wavesCleared += 1;
+    CreateBricks(bricks_, rng_, config_);
+    cascade_.Reset(bricks_.CellCount());
+    reactionEvents_.Clear();
+    reactionMessage_ = {};
+    ResetBallOnPaddle();
+    if (config_.stressBalls == 0) {
+        // Split-off balls would chip the new wave before the player launches.
+        extraBalls_.Clear();
+    }
+    gameOverSoundPlayed_ = false;
+}
+
+void Simulation::LaunchBall() {
+    if (ball_.inPlay) {
+        return;
+    }
+
+    float direction = rng_.Range(0, 1) == 0 ? -1.0f : 1.0f;
+    Vec2 initialDir{direction * 0.6f, -1.0f};
+    float lengthSq = initialDir.x * initialDir.x + initialDir.y * initialDir.y;
+    if (lengthSq > 0.0f) {
+        float invLength = 1.0f / std::sqrt(lengthSq);
+        initialDir.x *= invLength;
+        initialDir.y *= invLength;
+    }
+
+    ball_.velocity = {initialDir.x * ball_.speed, initialDir.y * ball_.speed};
+    ball_.inPlay = true;
+}
+
+void Simulation::ShowReaction(int text, int colorIndex) {
+    reactionMessage_.text = text;
+    reactionMessage_.colorIndex = colorIndex;
+    reactionMessage_.timer = 1.0f;
+    reactionMessage_.active = true;
+    stats_.reactionsTriggered += 1;
+}
+
+SimulationEvents Simulation::ConsumeEvents() {
+    SimulationEvents events = events_;
+    events_ = {};
+    return events;
+}
+
+void Simulation::PlayBounce() {
+    events_.bounces += 1;
+}
+
+void Simulation::PlayGameOver() {
+    if (!gameOverSoundPlayed_) {
+        events_.gameOver = true;
+        gameOverSoundPlayed_ = true;
+    }
+}
+
+void Simulation::HandleBallWallCollision(Vec2 normal) {
+    ball_.velocity = ReflectVelocity(ball_.velocity, normal);
+    PlayBounce();
+}
+
+void Simulation::HandleBallPaddleCollision() {
+    ball_.position.y = paddle_.rect.y - ball_.radius - 1.0f;
+    float paddleCenter = paddle_.rect.x + paddle_.rect.width * 0.5f;
+    float relative = (ball_.position.x - paddleCenter) / (paddle_.rect.width * 0.5f);
+    relative = std::clamp(relative, -1.0f, 1.0f);
+
+    Vec2 direction{relative, -1.0f};
+    float lengthSq = direction.x * direction.x + direction.y * direction.y;
+    if (lengthSq > 0.0f) {
+        float invLength = 1.0f / std::sqrt(lengthSq);
+        direction.x *= invLength;
+        direction.y *= invLength;
+    }
+    ball_.velocity = {direction.x * ball_.speed, direction.y * ball_.speed};
+
+    const ReactionEffect& reaction = rules_->OnPaddle(ball_.colorIndex, paddle_.colorIndex);
+    const bool overloadedTrigger = (reaction.flags & kEffectOverload) != 0;
+    const bool superconductTrigger = (reaction.flags & kEffectSuperconduct) != 0;
+    const bool freezeTrigger = (reaction.flags & kEffectFreezeBall) != 0;
+
+    ClearBallStatusEffects();
+
+    if (paddle_.colorIndex >= 0 && paddle_.colorIndex < kElementCount) {
+        ball_.colorIndex = paddle_.colorIndex;
+    } else {
+        ball_.colorIndex = -1;
+    }
+
+    ball_.overloaded = overloadedTrigger;
+    ball_.overloadEffect = reaction;
+    ball_.superconduct = superconductTrigger;
+    ball_.superconductTimer = superconductTrigger ? reaction.duration : 0.0f;
+
+    if (freezeTrigger) {
+        ball_.freezeReady = true;
+        ball_.frozen = true;
+        ball_.freezeTimer = reaction.duration;
+        ball_.storedVelocity = ball_.velocity;
+        ball_.velocity = {0.0f, 0.0f};
+    } else {
+        ball_.freezeReady = false;
+        ball_.frozen = false;
+        ball_.freezeTimer = 0.0f;
+        ball_.storedVelocity = {};
+    }
+
+    ball_.vaporizeReady = false;
+
+    if (reaction.text >= 0) {
+        ShowReaction(reaction.text, rules_->Text(reaction.text).colorIndex);
+    }
+
+    PlayBounce();
+}
+
+int Simulation::HandleBallBrickCollision(int cell, Vec2 normal) {
+    int bricksBroken = 0;
+
+    const int brickRow = bricks_.RowOf(cell);
+    const int brickCol = bricks_.ColOf(cell);
+    int freezeColorIndex = bricks_.Element(cell);
+    // A cluster this very hit freezes is not shattered by it.
+    const bool wasFrozen = bricks_.IsFrozen(cell);
+
+    if (ball_.freezeReady) {
+        int target = freezeColorIndex;
+        if (target != kColorIndexLightBlue) {
+            int frozenBricks = FreezeConnectedBricks(bricks_, brickRow, brickCol, target);
+            if (frozenBricks > 0) {
+                ShowReaction(freezeMessage_, kColorIndexLightBlue);
+            }
+        }
+        ball_.freezeReady = false;
+    }
+
+    bool brickBounced = false;
+
+    if (!ball_.superconduct) {
+        ball_.velocity = ReflectVelocity(ball_.velocity, normal);
+        brickBounced = true;
+    }
+
+    if (brickBounced) {
+        PlayBounce();
+    }
+
+    if (bricks_.IsFrozen(cell)) {
+        if (ball_.colorIndex == kColorIndexRed) {
+            ball_.colorIndex = kColorIndexBlue;
+            ball_.frozen = false;
+            ball_.freezeReady = false;
+            ball_.freezeTimer = 0.0f;
+            ball_.storedVelocity = {};
+            ball_.vaporizeReady = false;
+
+            ThawFrozenCluster(bricks_, brickRow, brickCol);
+            stats_.reactionsTriggered += 1;
+        } else {
+            ball_.frozen = false;
+            ball_.freezeReady = false;
+            ball_.freezeTimer = 0.0f;
+            ball_.storedVelocity = {};
+
+            if (wasFrozen) {
+                cascade_.Push(cell, CascadeAction::Break, ball_.colorIndex);
+                stats_.reactionsTriggered += 1;
+            }
+        }
+        return bricksBroken;
+    }
+
+    const int brickColorIndex = bricks_.Element(cell);
+    const ReactionEffect& reaction = rules_->OnBrick(ball_.colorIndex, brickColorIndex);
+    std::uint16_t flags = reaction.flags;
+
+    if ((flags & kEffectFreezeCluster) != 0 && FreezeConnectedBricks(bricks_, brickRow, brickCol, brickColorIndex) == 0) {
+        flags = 0;
+    }
+    if (flags != 0 && reaction.text >= 0) {
+        ShowReaction(reaction.text, rules_->Text(reaction.text).colorIndex);
+    }
+
+    const bool overloadTriggered = ball_.overloaded;
+    const bool instantBreak = (flags & kEffectDestroy) != 0 || overloadTriggered;
+    bool destroyedThisHit = false;
+
+    if (instantBreak) {
+        bricks_.Destroy(cell);
+        destroyedThisHit = true;
+    } else if ((flags & (kEffectRecolor | kEffectRepair)) != 0) {
+        if ((flags & kEffectRecolor) != 0) {
+            bricks_.SetElement(cell, reaction.recolor == kRecolorToBall ? ball_.colorIndex : reaction.recolor);
+        }
+        if ((flags & kEffectRepair) != 0) {
+            bricks_.SetCracked(cell, false);
+            bricks_.SetHitPoints(cell, std::max(bricks_.HitPoints(cell), 2));
+        }
+    } else {
+        bricks_.SetHitPoints(cell, bricks_.HitPoints(cell) - 1);
+        if (bricks_.HitPoints(cell) <= 0) {
+            bricks_.Destroy(cell);
+            destroyedThisHit = true;
+        } else {
+            bricks_.SetCracked(cell, true);
+        }
+    }
+
+    if ((flags & kEffectAoE) != 0) {
+        reactionEvents_.Schedule(ReactionEvent{brickRow, brickCol, ReactionKind::OverloadAoE, reaction.radius, reaction.shape,
+                                               ball_.colorIndex},
+                                 reaction.delay);
+    }
+
+    if (overloadTriggered) {
+        const ReactionEffect& overload = ball_.overloadEffect;
+        reactionEvents_.Schedule(ReactionEvent{brickRow, brickCol, ReactionKind::OverloadAoE, overload.radius, overload.shape,
+                                               ball_.colorIndex},
+                                 overload.delay);
+        if (overload.text >= 0) {
+            ShowReaction(overload.text, rules_->Text(overload.text).colorIndex);
+        }
+        ball_.overloaded = false;
+    }
+
+    if (destroyedThisHit) {
+        bricksBroken += 1;
+        cascade_.Broken(bricks_, cell, brickColorIndex, false, ball_.colorIndex);
+        TrySplitBall();
+        if ((flags & kEffectChain) != 0) {
+            ScheduleSurgeChain(reactionEvents_, bricks_, brickRow, brickCol, reaction.chainLength, reaction.chainDelay,
+                               ball_.colorIndex);
+        }
+    }
+
+    return bricksBroken;
+}
+
+int Simulation::AdvanceBall(float dt) {
+    enum class ContactKind { None, Wall, Paddle, Brick };
+
+    int bricksBroken = 0;
+    float timeLeft = dt;
+    // Bricks a superconducting ball has already entered this step; it phases through them.
+    int passedCells[MaxBallContactsPerStep];
+    int passedCount = 0;
+
+    for (int contact = 0; contact < MaxBallContactsPerStep && timeLeft > 0.0f; ++contact) {
+        if (!ball_.inPlay || ball_.frozen) {
+            break;
+        }
+
+        const Vec2 start = ball_.position;
+        const Vec2 delta{ball_.velocity.x * timeLeft, ball_.velocity.y * timeLeft};
+        const float radius = ball_.radius;
+
+        SweepHit earliest{};
+        ContactKind kind = ContactKind::None;
+        int hitCell = -1;
+        auto consider = [&](const SweepHit& hit, ContactKind hitKind, int cell) {
+            if (kind == ContactKind::None || hit.time < earliest.time) {
+                earliest = hit;
+                kind = hitKind;
+                hitCell = cell;
+            }
+        };
+
+        if (delta.x < 0.0f && start.x + delta.x < radius) {
+            consider({std::max(0.0f, (radius - start.x) / delta.x), {1.0f, 0.0f}}, ContactKind::Wall, -1);
+        } else if (delta.x > 0.0f && start.x + delta.x > config_.worldWidth - radius) {
+            consider({std::max(0.0f, (config_.worldWidth - radius - start.x) / delta.x), {-1.0f, 0.0f}}, ContactKind::Wall, -1);
+        }
+        if (delta.y < 0.0f && start.y + delta.y < radius) {
+            consider({std::max(0.0f, (radius - start.y) / delta.y), {0.0f, 1.0f}}, ContactKind::Wall, -1);
+        }
+
+        SweepHit hit{};
+        if (SweepCircleRect(start, delta, radius, paddle_.rect, hit)) {
+            consider(hit, ContactKind::Paddle, -1);
+        }
+
+        const float sweepMinX = std::min(start.x, start.x + delta.x) - radius;
+        const float sweepMaxX = std::max(start.x, start.x + delta.x) + radius;
+        const float sweepMinY = std::min(start.y, start.y + delta.y) - radius;
+        const float sweepMaxY = std::max(start.y, start.y + delta.y) + radius;
+        // Bricks sit on a regular grid, so only the cells under the swept box can be hit.
+        const BrickField::CellRange candidates =
+            bricks_.CellsOverlapping({sweepMinX, sweepMinY, sweepMaxX - sweepMinX, sweepMaxY - sweepMinY});
+        for (int row = candidates.rowBegin; row < candidates.rowEnd; ++row) {
+            const int rowEnd = bricks_.CellIndex(row, candidates.colEnd);
+            for (int cell = bricks_.NextActive(bricks_.CellIndex(row, candidates.colBegin), rowEnd); cell != -1;
+                 cell = bricks_.NextActive(cell + 1, rowEnd)) {
+                const Rect& rect = bricks_.BrickRect(cell);
+                if (rect.x > sweepMaxX || rect.x + rect.width < sweepMinX || rect.y > sweepMaxY || rect.y + rect.height < sweepMinY) {
+                    continue;
+                }
+                if (ball_.superconduct) {
+                    if (std::find(passedCells, passedCells + passedCount, cell) != passedCells + passedCount ||
+                        CircleOverlapsRect(start, radius, rect)) {
+                        continue;
+                    }
+                }
+                if (SweepCircleRect(start, delta, radius, rect, hit)) {
+                    consider(hit, ContactKind::Brick, cell);
+                }
+            }
+        }
+
+        if (kind == ContactKind::None) {
+            ball_.position = {start.x + delta.x, start.y + delta.y};
+            break;
+        }
+
+        ball_.position = {start.x + delta.x * earliest.time, start.y + delta.y * earliest.time};
+        timeLeft -= timeLeft * earliest.time;
+
+        if (kind == ContactKind::Wall) {
+            HandleBallWallCollision(earliest.normal);
+        } else if (kind == ContactKind::Paddle) {
+            HandleBallPaddleCollision();
+        } else {
+            if (ball_.superconduct) {
+                passedCells[passedCount++] = hitCell;
+            }
+            bricksBroken += HandleBallBrickCollision(hitCell, earliest.normal);
+        }
+    }
+
+    return bricksBroken;
+}
+
+int Simulation::ResolveReactionEvents(float dt) {
+    reactionEvents_.Advance(dt);
+
+    ReactionEvent event{};
+    while (reactionEvents_.PopDue(event)) {
+        if (event.kind == ReactionKind::OverloadAoE) {
+            QueueOverloadedAoE(cascade_, bricks_, event.row, event.col, event.radius, event.shape, event.element);
+        } else if (event.kind == ReactionKind::SurgeChain) {
+            if (bricks_.InBounds(event.row, event.col)) {
+                cascade_.Push(bricks_.CellIndex(event.row, event.col), CascadeAction::Break, event.element);
+            }
+        }
+    }
+    return cascade_.Run(bricks_, config_.cascadeBudget);
+}
+
+void Simulation::TrySplitBall() {
+    if (config_.splitChancePercent <= 0 || extraBalls_.Size() + 2 > static_cast<std::size_t>(config_.maxExtraBalls)) {
+        return;
+    }
+    if (rng_.Range(1, 100) > config_.splitChancePercent) {
+        return;
+    }
+
+    // Two copies fanned out either side of the main ball's heading.
+    const float spread = 0.35f;
+    const float c = std::cos(spread);
+    const float s = std::sin(spread);
+    const Vec2 v = ball_.velocity;
+    extraBalls_.Add(ball_.position, {v.x * c - v.y * s, v.x * s + v.y * c});
+    extraBalls_.Add(ball_.position, {v.x * c + v.y * s, -v.x * s + v.y * c});
+    ShowReaction(splitMessage_, kColorIndexNone);
+}
+
+void Simulation::SpawnStressBalls() {
+    // Spread deterministically over the open band between the bricks and the paddle,
+    // heading in golden-angle steps so no two balls move in lockstep.
+    const float radius = extraBalls_.Radius();
+    const float bandTop = bricks_.LayoutBottom() + radius;
+    const float bandHeight = std::max(paddle_.rect.y - 2.0f * radius - bandTop, 1.0f);
+    const float bandWidth = std::max(config_.worldWidth - 2.0f * radius, 1.0f);
+    for (int i = 0; i < config_.stressBalls; ++i) {
+        float x = radius + std::fmod(static_cast<float>(i) * 0.618034f * bandWidth, bandWidth);
+        float y = bandTop + std::fmod(static_cast<float>(i) * 0.754878f * bandHeight, bandHeight);
+        float angle = static_cast<float>(i) * 2.399963f;
+        extraBalls_.Add({x, y}, {std::cos(angle) * ball_.speed, std::sin(angle) * ball_.speed});
+    }
+}
+
+int Simulation::UpdateExtraBalls(float dt) {
+    if (extraBalls_.Empty()) {
+        return 0;
+    }
+
+    const bool closedFloor = config_.stressBalls > 0;
+    const float floorY = closedFloor ? config_.worldHeight : std::numeric_limits<float>::infinity();
+    extraBalls_.Integrate(dt, config_.worldWidth, floorY);
+    extraBalls_.BounceOffPaddle(paddle_.rect);
+
+    // Most balls are usually in the open space under the bricks; skip those outright.
+    int broken = 0;
+    const float reach = bricks_.LayoutBottom() + extraBalls_.Radius();
+    const float* ys = extraBalls_.Y();
+    for (std::size_t i = 0; i < extraBalls_.Size(); ++i) {
+        if (ys[i] < reach) {
+            broken += CollideExtraBallWithBricks(i);
+        }
+    }
+    if (!closedFloor) {
+        extraBalls_.RemoveBelow(config_.worldHeight + extraBalls_.Radius());
+    }
+    return broken;
+}
+
+// Extra balls move a few pixels per step, far less than a brick, so a discrete overlap
+// test against the cells under the ball is enough. Each ball hits at most one brick per
+// step, bounces off its shallower side and chips it like a neutral ball.
+int Simulation::CollideExtraBallWithBricks(std::size_t index) {
+    float& x = extraBalls_.X()[index];
+    float& y = extraBalls_.Y()[index];
+    const float radius = extraBalls_.Radius();
+    const Vec2 center{x, y};
+
+    const BrickField::CellRange candidates =
+        bricks_.CellsOverlapping({x - radius, y - radius, 2.0f * radius, 2.0f * radius});
+    for (int row = candidates.rowBegin; row < candidates.rowEnd; ++row) {
+        const int rowEnd = bricks_.CellIndex(row, candidates.colEnd);
+        for (int cell = bricks_.NextActive(bricks_.CellIndex(row, candidates.colBegin), rowEnd); cell != -1;
+             cell = bricks_.NextActive(cell + 1, rowEnd)) {
+            const Rect& rect = bricks_.BrickRect(cell);
+            if (!CircleOverlapsRect(center, radius, rect)) {
+                continue;
+            }
+
+            float& vx = extraBalls_.VelocityX()[index];
+            float& vy = extraBalls_.VelocityY()[index];
+            const float pushLeft = x + radius - rect.x;
+            const float pushRight = rect.x + rect.width - (x - radius);
+            const float pushUp = y + radius - rect.y;
+            const float pushDown = rect.y + rect.height - (y - radius);
+            if (std::min(pushLeft, pushRight) < std::min(pushUp, pushDown)) {
+                x += pushLeft < pushRight ? -pushLeft : pushRight;
+                vx = pushLeft < pushRight ? -std::fabs(vx) : std::fabs(vx);
+            } else {
+                y += pushUp < pushDown ? -pushUp : pushDown;
+                vy = pushUp < pushDown ? -std::fabs(vy) : std::fabs(vy);
+            }
+
+            if (bricks_.IsFrozen(cell)) {
+                return 0;
+            }
+            bricks_.SetHitPoints(cell, bricks_.HitPoints(cell) - 1);
+            if (bricks_.HitPoints(cell) <= 0) {
+                const int brickElement = bricks_.Element(cell);
+                bricks_.Destroy(cell);
+                cascade_.Broken(bricks_, cell, brickElement, false, kColorIndexNone);
+                return 1;
+            }
+            bricks_.SetCracked(cell, true);
+            return 0;
+        }
+    }
+    return 0;
+}
+
+void Simulation::UpdateFreezeState(float dt) {
+    if (!ball_.inPlay || !ball_.frozen) {
+        return;
+    }
+
+    ball_.freezeTimer -= dt;
+    ball_.position.x = paddle_.rect.x + paddle_.rect.width * 0.5f;
+    ball_.position.y = paddle_.rect.y - ball_.radius - 1.0f;
+    if (ball_.freezeTimer <= 0.0f) {
+        ball_.frozen = false;
+        float storedSpeed = std::sqrt(ball_.storedVelocity.x * ball_.storedVelocity.x + ball_.storedVelocity.y * ball_.storedVelocity.y);
+        if (storedSpeed <= 0.001f) {
+            ball_.velocity = {0.0f, -ball_.speed};
+        } else {
+            ball_.velocity = ball_.storedVelocity;
+        }
+        ball_.storedVelocity = {};
+    }
+}
+
+void Simulation::Step(const InputFrame& input, float dt) {
+    if (!gameOver_ && input.togglePause) {
+        paused_ = !paused_;
+    }
+
+    if (!paused_) {
+        UpdateFreezeState(dt);
+        if (ball_.superconduct && ball_.superconductTimer > 0.0f) {
+            ball_.superconductTimer -= dt;
+            if (ball_.superconductTimer <= 0.0f) {
+                ball_.superconduct = false;
+                ball_.superconductTimer = 0.0f;
+            }
+        }
+        if (ball_.superconduct && ball_.superconductTimer > 0.0f) {
+            ball_.superconductTimer -= dt;
+            if (ball_.superconductTimer <= 0.0f) {
+                ball_.superconduct = false;
+                ball_.superconductTimer = 0.0f;
+            }
+        }
+        if (colorSwitchCooldown_ > 0.0f) {
+            colorSwitchCooldown_ = std::max(0.0f, colorSwitchCooldown_ - dt);
+        }
+        if (reactionMessage_.active) {
+            reactionMessage_.timer -= dt;
+            if (reactionMessage_.timer <= 0.0f) {
+                reactionMessage_.active = false;
+                reactionMessage_.text = -1;
+            }
+        }
+    }
+
+    if (!paused_ && !gameOver_) {
+        stats_.runTime += dt;
+        HandleMovement(input, dt);
+        HandlePaddleColorInput(input);
+    }
+
+    if (!ball_.inPlay) {
+        ball_.position.x = paddle_.rect.x + paddle_.rect.width * 0.5f;
+        ball_.position.y = paddle_.rect.y - ball_.radius - 1.0f;
+    }
+
+    bool canAct = !paused_ && !gameOver_;
+
+    if (canAct && input.launch) {
+        LaunchBall();
+    }
+
+    if (canAct && input.forfeit) {
+        lives_ = 0;
+        gameOver_ = true;
+        ball_.inPlay = false;
+        PlayGameOver();
+    }
+
+    if (canAct && ball_.inPlay && !ball_.frozen) {
+        score_ += AdvanceBall(dt);
+
+        if (bricks_.CountActive() == 0) {
+            SpawnWave();
+            ball_.speed *= 1.15f;
+        }
+
+        if (ball_.position.y - ball_.radius > config_.worldHeight) {
+            lives_ -= 1;
+            if (lives_ <= 0) {
+                gameOver_ = true;
+                PlayGameOver();
+            }
+            ResetBallOnPaddle();
+        }
+    }
+
+    if (!paused_ && !gameOver_) {
+        score_ += UpdateExtraBalls(dt);
+        int extraRemoved = ResolveReactionEvents(dt);
+        if (extraRemoved > 0) {
+            score_ += extraRemoved;
+        }
+        if (bricks_.CountActive() == 0) {
+            SpawnWave();
+            ball_.speed *= 1.15f;
+        }
+    }
+
+    if (gameOver_ && input.restart) {
+        // Each new run gets its own seed, derived from the last one so a session stays reproducible.
+        seed_ = rng_.Next();
+        ResetRun();
+    }
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "BallSwarm.h"
+#include "BrickField.h"
+#include "BrickReactions.h"
+#include "Elements.h"
+#include "GameConstants.h"
+#include "InputFrame.h"
+#include "ReactionCascade.h"
+#include "ReactionQueue.h"
+#include "ReactionRules.h"
+#include "Rng.h"
+#include "SimTypes.h"
+#include "SimulationConfig.h"
+
+struct Paddle {
+    Rect rect{};
+    float speed{640.0f};
+    int colorIndex{0};
+};
+
+struct Ball {
+    Vec2 position{};
+    Vec2 velocity{};
+    float radius{12.0f};
+    float speed{420.0f};
+    bool inPlay{false};
+    int colorIndex{-1};
+    bool overloaded{false};
+    ReactionEffect overloadEffect{};  // the blast the next brick hit triggers
+    bool superconduct{false};
+    float superconductTimer{0.0f};
+    bool frozen{false};
+    bool freezeReady{false};
+    float freezeTimer{0.0f};
+    Vec2 storedVelocity{};
+    bool vaporizeReady{false};
+};
+
+// The banner holds an interned message id; Simulation::MessageText turns it back into
+// text, so showing a reaction never copies a string.
+struct ReactionMessage {
+    int text{-1};
+    int colorIndex{kColorIndexNone};
+    float timer{0.0f};
+    bool active{false};
+};
+
+// Per-run counters for balancing and regression runs.
+struct SimulationStats {
+    int wavesCleared{0};
+    int reactionsTriggered{0};
+    float runTime{0.0f};  // seconds of unpaused play
+};
+
+// Things the simulation wants the shell to react to (sounds) since the last ConsumeEvents.
+struct SimulationEvents {
+    int bounces{0};
+    bool gameOver{false};
+};
+
+// The whole game rules and physics with no window, input or audio dependency.
+// The shell feeds it one InputFrame per fixed step and reads its state back to draw.
+class Simulation {
+public:
+    Simulation();
+    explicit Simulation(const SimulationConfig& config);
+
+    // Sets the seed for the next ResetRun; a run is fully determined by its seed and inputs.
+    void Seed(std::uint64_t seed);
+    void ResetRun();
+    void Step(const InputFrame& input, float dt);
+    SimulationEvents ConsumeEvents();
+
+    const Paddle& GetPaddle() const { return paddle_; }
+    const Ball& GetBall() const { return ball_; }
+    const BallSwarm& GetExtraBalls() const { return extraBalls_; }
+    const BrickField& GetBricks() const { return bricks_; }
+    const ReactionMessage& GetReactionMessage() const { return reactionMessage_; }
+    // Every banner text the simulation can show, by id; the pointers stay valid for its lifetime.
+    const char* MessageText(int id) const { return messageTexts_[id]; }
+    int MessageCount() const { return static_cast<int>(messageTexts_.size()); }
+    int Score() const { return score_; }
+    int Lives() const { return lives_; }
+    bool IsPaused() const { return paused_; }
+    bool IsGameOver() const { return gameOver_; }
+    std::uint64_t RunSeed() const { return seed_; }
+    const SimulationStats& Stats() const { return stats_; }
+    const SimulationConfig& Config() const { return config_; }
+    // A renderer caching the bricks calls this once it has caught up with their changes.
+    void ClearBrickChanges() { bricks_.ClearDirty(); }
+
+private:
+    // Lets elemental_bench time individual hot paths against a prepared state.
+    friend class SimulationProbe;
+
+    void LaunchBall();
+    void SpawnWave();
+    int AdvanceBall(float dt);
+    void HandleBallWallCollision(Vec2 normal);
+    void HandleBallPaddleCollision();
+    int HandleBallBrickCollision(int cell, Vec2 normal);
+    int ResolveReactionEvents(float dt);
+    void TrySplitBall();
+    void SpawnStressBalls();
+    int UpdateExtraBalls(float dt);
+    int CollideExtraBallWithBricks(std::size_t index);
+    void UpdateFreezeState(float dt);
+    void ResetBallOnPaddle();
+    void ResetPaddlePosition();
+    void InternMessages();
+    void ShowReaction(int text, int colorIndex);
+    void PlayBounce();
+    void PlayGameOver();
+    void HandleMovement(const InputFrame& input, float dt);
+    void HandlePaddleColorInput(const InputFrame& input);
+    void ClearBallStatusEffects();
+
+private:
+    SimulationConfig config_{};
+    const ReactionRules* rules_{&ReactionRules::Defaults()};
+    Paddle paddle_{};
+    Ball ball_{};
+    BallSwarm extraBalls_;
+    BrickField bricks_;
+    ReactionQueue reactionEvents_;
+    ReactionCascade cascade_;
+    ReactionMessage reactionMessage_{};
+    // The rules' messages, in rule order, followed by the built-in ones.
+    std::vector<const char*> messageTexts_;
+    int freezeMessage_{-1};
+    int splitMessage_{-1};
+    SimulationEvents events_{};
+    SimulationStats stats_{};
+    Rng rng_{};
+    std::uint64_t seed_{0};
+
+    int score_{0};
+    int lives_{1};
+    bool paused_{false};
+    bool gameOver_{false};
+    bool gameOverSoundPlayed_{false};
+    float colorSwitchCooldown_{0.0f};
+};
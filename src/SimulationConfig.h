@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "GameConstants.h"
+
+class ReactionRules;
+
+// Bounds on the settings that come from outside (flags, level files, replay files).
+constexpr int kMaxGridSide = 4096;
+constexpr float kMaxBrickSize = 10000.0f;
+constexpr float kMaxBrickSpacing = 1000.0f;
+constexpr float kMaxBrickTopOffset = 10000.0f;
+
+// Wave generation odds. Each chunk of 3-6 bricks rolls 1-100: rolls up to neutralPercent
+// are yellow, the next greenPercent are green, and the rest split evenly between red,
+// blue, purple and light blue. Every brick then has gapPercent odds of being left out.
+struct SpawnWeights {
+    int neutralPercent{60};
+    int greenPercent{4};
+    int gapPercent{17};
+    int minChunk{3};
+    int maxChunk{6};
+};
+
+// Playfield shape. With brickWidth 0 the columns are stretched to fill worldWidth;
+// otherwise bricks keep their size and FitWorldToGrid sizes the world around them.
+// The paddle sits near the bottom of worldHeight and the ball is lost below it.
+//
+// A brick broken by the main ball has splitChancePercent odds of splitting off two
+// extra balls (while fewer than maxExtraBalls are in play); the stock game has no splits.
+// Extra balls are cleared with each new wave. stressBalls > 0 instead starts every run
+// with that many extra balls, keeps them across waves and closes the floor so they
+// never drain.
+//
+// Chain reactions process at most cascadeBudget brick breaks and recolours per step and
+// carry the rest over, so one huge cascade cannot stall a frame.
+//
+// rules, when set, replaces the stock reactions and must outlive every Simulation using it.
+struct SimulationConfig {
+    int brickRows{BrickRows};
+    int brickCols{BrickCols};
+    float brickWidth{0.0f};
+    float brickHeight{BrickHeight};
+    float brickSpacing{BrickSpacing};
+    float brickTopOffset{BrickTopOffset};
+    float worldWidth{static_cast<float>(ScreenWidth)};
+    float worldHeight{static_cast<float>(ScreenHeight)};
+    SpawnWeights spawn{};
+    int splitChancePercent{0};
+    int maxExtraBalls{24};
+    int stressBalls{0};
+    int cascadeBudget{4096};
+    const ReactionRules* rules{nullptr};
+};
+
+// True if every setting is within the bounds above and the ones the simulation relies on
+// (chunk sizes of at least one brick, a positive cascade budget, a finite world at least
+// the size of the screen).
+inline bool WithinLimits(const SimulationConfig& config) {
+    auto inRange = [](float value, float minValue, float maxValue) {
+        return std::isfinite(value) && value >= minValue && value <= maxValue;
+    };
+    auto isPercent = [](int value) { return value >= 0 && value <= 100; };
+    return config.brickRows >= 1 && config.brickRows <= kMaxGridSide && config.brickCols >= 1 &&
+           config.brickCols <= kMaxGridSide && inRange(config.brickWidth, 0.0f, kMaxBrickSize) &&
+           inRange(config.brickHeight, 1.0f, kMaxBrickSize) && inRange(config.brickSpacing, 0.0f, kMaxBrickSpacing) &&
+           inRange(config.brickTopOffset, 0.0f, kMaxBrickTopOffset) && std::isfinite(config.worldWidth) &&
+           config.worldWidth >= ScreenWidth && std::isfinite(config.worldHeight) &&
+           config.worldHeight >= ScreenHeight && isPercent(config.spawn.neutralPercent) &&
+           isPercent(config.spawn.greenPercent) && isPercent(config.spawn.gapPercent) && config.spawn.minChunk >= 1 &&
+           config.spawn.minChunk <= config.spawn.maxChunk && isPercent(config.splitChancePercent) &&
+           config.maxExtraBalls >= 0 && config.stressBalls >= 0 && config.cascadeBudget > 0;
+}
+
+// Grows the world to hold the brick grid with the same open space below the bricks as
+// the stock layout. Never shrinks below the screen. Stretched columns that would come
+// out narrower than a brick is tall fall back to the stock brick width.
+inline void FitWorldToGrid(SimulationConfig& config) {
+    constexpr float kStockPlayArea = ScreenHeight - (BrickTopOffset + BrickRows * (BrickHeight + BrickSpacing));
+    if (config.brickWidth <= 0.0f) {
+        const float stretched = (config.worldWidth - (config.brickCols + 1) * config.brickSpacing) / config.brickCols;
+        if (stretched < config.brickHeight) {
+            config.brickWidth = BrickWidth;
+        }
+    }
+    if (config.brickWidth > 0.0f) {
+        const float gridWidth = config.brickSpacing + config.brickCols * (config.brickWidth + config.brickSpacing);
+        config.worldWidth = std::max(static_cast<float>(ScreenWidth), gridWidth);
+    }
+    const float gridBottom = config.brickTopOffset + config.brickRows * (config.brickHeight + config.brickSpacing);
+    config.worldHeight = std::max(static_cast<float>(ScreenHeight), gridBottom + kStockPlayArea);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdlib>
+#include <string>
+
+// Helpers shared by the "key = value" file parsers (level files and reaction rules).
+
+// text without leading and trailing spaces, tabs and carriage returns.
+inline std::string Trim(const std::string& text) {
+    const char* whitespace = " \t\r";
+    std::size_t begin = text.find_first_not_of(whitespace);
+    if (begin == std::string::npos) {
+        return {};
+    }
+    std::size_t end = text.find_last_not_of(whitespace);
+    return text.substr(begin, end - begin + 1);
+}
+
+// Parses all of text as a number in [minValue, maxValue].
+inline bool ParseNumber(const std::string& text, float minValue, float maxValue, float& value) {
+    char* end = nullptr;
+    value = std::strtof(text.c_str(), &end);
+    return end != text.c_str() && *end == '\0' && value >= minValue && value <= maxValue;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs fn(index, worker) for every index in [0, count) on workerCount threads.
+//
+// Indices are cut into chunks and dealt round-robin onto one deque per worker. A worker
+// pops its own chunks from the back and, once it runs dry, steals from the front of the
+// other workers' deques, so long-running games on one thread don't leave the rest idle.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int workerCount) : workerCount_(std::max(1, workerCount)) {}
+
+    int WorkerCount() const { return workerCount_; }
+
+    template <typename Fn>
+    void ParallelFor(std::size_t count, std::size_t chunkSize, Fn&& fn) {
+        chunkSize = std::max<std::size_t>(1, chunkSize);
+        std::vector<WorkerQueue> queues(workerCount_);
+        std::size_t chunkIndex = 0;
+        for (std::size_t begin = 0; begin < count; begin += chunkSize, ++chunkIndex) {
+            queues[chunkIndex % workerCount_].chunks.push_back({begin, std::min(count, begin + chunkSize)});
+        }
+
+        auto work = [&](int worker) {
+            Chunk chunk{};
+            while (PopLocal(queues[worker], chunk) || Steal(queues, worker, chunk)) {
+                for (std::size_t i = chunk.begin; i < chunk.end; ++i) {
+                    fn(i, worker);
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workerCount_ - 1);
+        for (int worker = 1; worker < workerCount_; ++worker) {
+            threads.emplace_back(work, worker);
+        }
+        work(0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+private:
+    struct Chunk {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    static bool PopLocal(WorkerQueue& queue, Chunk& chunk) {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.chunks.empty()) {
+            return false;
+        }
+        chunk = queue.chunks.back();
+        queue.chunks.pop_back();
+        return true;
+    }
+
+    bool Steal(std::vector<WorkerQueue>& queues, int thief, Chunk& chunk) const {
+        for (int offset = 1; offset < workerCount_; ++offset) {
+            WorkerQueue& victim = queues[(thief + offset) % workerCount_];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.chunks.empty()) {
+                chunk = victim.chunks.front();
+                victim.chunks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int workerCount_;
+};
@@ -1,5 +1,12 @@
 // Basic 960x720 Breakout clone using raylib and C++.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <string>
 
 #include <raylib.h>
 
@@ -7,9 +14,126 @@
 #include "ElementalGame.h"
 #include "GameConstants.h"
 #include "InstructionsScreen.h"
+#include "LevelFile.h"
+#include "ReactionRules.h"
+#include "Replay.h"
+#include "Simulation.h"
+
+namespace {
+// Plays a recording through the simulation as fast as possible, without a window.
+int RunHeadlessReplay(ReplayPlayer& replay, const SimulationConfig& config) {
+    Simulation simulation(config);
+    simulation.Seed(replay.Seed());
+    simulation.ResetRun();
+
+    const float stepDt = 1.0f / static_cast<float>(replay.StepHz());
+    auto start = std::chrono::steady_clock::now();
+    InputFrame input{};
+    while (replay.Next(input)) {
+        simulation.Step(input, stepDt);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double simulated = static_cast<double>(replay.StepsPlayed()) / replay.StepHz();
+    std::printf("replayed %llu steps (%.1f s of play) in %.3f s: score %d, lives %d, game over %s, seed %llu\n",
+                static_cast<unsigned long long>(replay.StepsPlayed()), simulated, elapsed, simulation.Score(),
+                simulation.Lives(), simulation.IsGameOver() ? "yes" : "no",
+                static_cast<unsigned long long>(simulation.RunSeed()));
+    return 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    int simulationHz = DefaultSimulationHz;
+    std::uint64_t seed = static_cast<std::uint64_t>(std::time(nullptr));
+    std::string recordPath;
+    std::string replayPath;
+    bool render = true;
+    BrickRenderer brickRenderer = BrickRenderer::Cached;
+    bool renderStats = false;
+    SimulationConfig config{};
+    ReactionRules rules = ReactionRules::Defaults();
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--hz") == 0 && i + 1 < argc) {
+            simulationHz = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 0);
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--no-render") == 0) {
+            render = false;
+        } else if (std::strcmp(argv[i], "--bricks") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if (std::strcmp(name, "cached") == 0) {
+                brickRenderer = BrickRenderer::Cached;
+            } else if (std::strcmp(name, "mesh") == 0) {
+                brickRenderer = BrickRenderer::Mesh;
+            } else if (std::strcmp(name, "direct") == 0) {
+                brickRenderer = BrickRenderer::Direct;
+            } else {
+                std::fprintf(stderr, "Unknown brick renderer '%s' (cached, mesh or direct)\n", name);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--render-stats") == 0) {
+            renderStats = true;
+        } else if (std::strcmp(argv[i], "--split-chance") == 0 && i + 1 < argc) {
+            config.splitChancePercent = std::clamp(std::atoi(argv[++i]), 0, 100);
+        } else if (std::strcmp(argv[i], "--stress-balls") == 0 && i + 1 < argc) {
+            config.stressBalls = std::max(std::atoi(argv[++i]), 0);
+        } else if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            const char* path = argv[++i];
+            std::string error;
+            if (!LoadLevelFile(path, config, error)) {
+                std::fprintf(stderr, "Could not load level '%s': %s\n", path, error.c_str());
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--rules") == 0 && i + 1 < argc) {
+            const char* path = argv[++i];
+            std::string error;
+            if (!LoadReactionRules(path, rules, error)) {
+                std::fprintf(stderr, "Could not load rules '%s': %s\n", path, error.c_str());
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--rows") == 0 && i + 1 < argc) {
+            config.brickRows = std::clamp(std::atoi(argv[++i]), 1, kMaxGridSide);
+        } else if (std::strcmp(argv[i], "--cols") == 0 && i + 1 < argc) {
+            config.brickCols = std::clamp(std::atoi(argv[++i]), 1, kMaxGridSide);
+        } else if (std::strcmp(argv[i], "--brick-width") == 0 && i + 1 < argc) {
+            config.brickWidth = std::clamp(static_cast<float>(std::atof(argv[++i])), 0.0f, kMaxBrickSize);
+        } else if (std::strcmp(argv[i], "--brick-height") == 0 && i + 1 < argc) {
+            config.brickHeight = std::clamp(static_cast<float>(std::atof(argv[++i])), 1.0f, kMaxBrickSize);
+        } else if (std::strcmp(argv[i], "--spacing") == 0 && i + 1 < argc) {
+            config.brickSpacing = std::clamp(static_cast<float>(std::atof(argv[++i])), 0.0f, kMaxBrickSpacing);
+        }
+    }
+    if (!render && replayPath.empty()) {
+        std::fprintf(stderr, "--no-render needs --replay\n");
+        return 1;
+    }
+    FitWorldToGrid(config);
+    config.rules = &rules;
+
+    ReplayPlayer replay;
+    if (!replayPath.empty()) {
+        if (!replay.LoadFromFile(replayPath)) {
+            std::fprintf(stderr, "Could not read replay '%s'\n", replayPath.c_str());
+            return 1;
+        }
+        seed = replay.Seed();
+        simulationHz = replay.StepHz();
+        replay.ApplyConfig(config);
+        if (replay.RulesHash() != rules.Hash()) {
+            std::fprintf(stderr, "Replay '%s' was recorded with other reaction rules; pass the --rules file it was recorded with\n",
+                         replayPath.c_str());
+            return 1;
+        }
+        if (!render) {
+            return RunHeadlessReplay(replay, config);
+        }
+    }
 
-int main() {
-    SetRandomSeed(static_cast<unsigned int>(std::time(nullptr)));
     InitWindow(ScreenWidth, ScreenHeight, "Elemental Breakout");
     SetTargetFPS(60);
 
@@ -17,15 +141,26 @@ int main() {
     audio.Init();
 
     InstructionsScreen instructions;
-    instructions.Initialize(ScreenWidth, ScreenHeight);
+    instructions.Initialize(ScreenWidth, ScreenHeight, rules);
 
-    ElementalGame game;
+    ReplayRecorder recorder;
+    ElementalGame game(config);
+    game.SetSimulationRate(simulationHz);
+    game.Seed(seed);
+    game.SetBrickRenderer(brickRenderer);
+    game.SetShowRenderStats(renderStats);
+    if (!recordPath.empty()) {
+        game.SetRecorder(&recorder);
+    }
+    if (!replayPath.empty()) {
+        game.SetReplay(&replay);
+    }
     game.Initialize(&audio);
 
     while (!WindowShouldClose()) {
         float dt = GetFrameTime();
 
-        if (instructions.IsActive()) {
+        if (instructions.IsActive() && replayPath.empty()) {
             instructions.Update(dt);
             instructions.Draw();
             if (!instructions.IsActive()) {
@@ -36,8 +171,15 @@ int main() {
 
         game.Update(dt);
         game.Draw();
+        audio.Update();
+    }
+
+    if (!recordPath.empty() && !recorder.SaveToFile(recordPath)) {
+        std::fprintf(stderr, "Could not write replay '%s'\n", recordPath.c_str());
     }
 
+    game.Shutdown();
+    instructions.Shutdown();
     audio.Shutdown();
     CloseWindow();
     return 0;